@@ -117,7 +117,8 @@ return {
   },
   debug = {
     determinism_test_cloned_cosmoi_count = 0,
-    input_recording_mode = "DISABLED"
+    input_recording_mode = "DISABLED",
+    profiler_window = 256
   },
   debug_drawing = {
     draw_cast_rays = false,
@@ -147,7 +148,9 @@ return {
   },
   editor = {
 	player = {
-		snapshot_interval_in_steps = 800
+		snapshot_interval_in_steps = 800,
+		snapshot_keyframe_interval = 8,
+		snapshot_memory_budget_mb = 512
 	},
     grid = {
       render = {
@@ -500,7 +503,19 @@ return {
   },
 
   dedicated_server = {
-
+	num_arenas = 1,
+	num_arena_threads = 0,
+	trace_file_path = ""
+  },
+
+  headless_benchmark = {
+	arena = "",
+	num_steps = 3000,
+	num_players = 8,
+	rng_seed = 0,
+	num_additional_workers = 0,
+	recorded_entropy_path = "",
+	output_path = ""
   },
 
   default_client_start = {
@@ -119,6 +119,9 @@ bool b2BroadPhase::QueryCallback(int32 proxyId)
 }
 
 b2BroadPhase& b2BroadPhase::operator=(const b2BroadPhase& b) {
+	b2Free(m_moveBuffer);
+	b2Free(m_pairBuffer);
+
 	m_proxyCount = b.m_proxyCount;
 
 	m_moveCapacity = b.m_moveCapacity;
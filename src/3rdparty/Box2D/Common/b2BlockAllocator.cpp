@@ -21,6 +21,8 @@
 #include <climits>
 #include <cstring>
 #include <memory>
+#include <algorithm>
+#include <functional>
 
 #include "augs/build_settings/setting_debug_physics_world_cache_copy.h"
 
@@ -66,6 +68,7 @@ b2BlockAllocator::b2BlockAllocator()
 
 	m_chunkSpace = b2_chunkArrayIncrement;
 	m_chunkCount = 0;
+	m_largeBlockCount = 0;
 	m_chunks = (b2Chunk*)b2Alloc(m_chunkSpace * sizeof(b2Chunk));
 
 	memset(m_chunks, 0, m_chunkSpace * sizeof(b2Chunk));
@@ -115,6 +118,7 @@ void* b2BlockAllocator::Allocate(int32 size)
 
 	if (size > b2_maxBlockSize)
 	{
+		++m_largeBlockCount;
 		return b2Alloc(size);
 	}
 
@@ -179,6 +183,7 @@ void b2BlockAllocator::Free(void* p, int32 size)
 
 	if (size > b2_maxBlockSize)
 	{
+		--m_largeBlockCount;
 		b2Free(p);
 		return;
 	}
@@ -229,3 +234,96 @@ void b2BlockAllocator::Clear()
 
 	memset(m_freeLists, 0, sizeof(m_freeLists));
 }
+
+void b2BlockAllocator::CloneFrom(const b2BlockAllocator& source)
+{
+	// The caller must fall back to a deep copy if any block lives outside of the chunks.
+	b2Assert(source.m_largeBlockCount == 0 && m_largeBlockCount == 0);
+
+	for (int32 i = source.m_chunkCount; i < m_chunkCount; ++i)
+	{
+		b2Free(m_chunks[i].blocks);
+		m_chunks[i].blocks = NULL;
+	}
+
+	if (m_chunkSpace < source.m_chunkCount)
+	{
+		b2Chunk* oldChunks = m_chunks;
+		m_chunkSpace = source.m_chunkSpace;
+		m_chunks = (b2Chunk*)b2Alloc(m_chunkSpace * sizeof(b2Chunk));
+		memset(m_chunks, 0, m_chunkSpace * sizeof(b2Chunk));
+		memcpy(m_chunks, oldChunks, m_chunkCount * sizeof(b2Chunk));
+		b2Free(oldChunks);
+	}
+
+	for (int32 i = m_chunkCount; i < source.m_chunkCount; ++i)
+	{
+		m_chunks[i].blocks = (b2Block*)b2Alloc(b2_chunkSize);
+	}
+
+	m_chunkCount = source.m_chunkCount;
+	m_relocations.resize(m_chunkCount);
+
+	for (int32 i = 0; i < m_chunkCount; ++i)
+	{
+		m_chunks[i].blockSize = source.m_chunks[i].blockSize;
+		memcpy(m_chunks[i].blocks, source.m_chunks[i].blocks, b2_chunkSize);
+
+		m_relocations[i].sourceBlocks = (const int8*)source.m_chunks[i].blocks;
+		m_relocations[i].index = i;
+	}
+
+	std::sort(
+		m_relocations.begin(),
+		m_relocations.end(),
+		[](const b2ChunkRelocation& a, const b2ChunkRelocation& b)
+		{
+			return std::less<const int8*>()(a.sourceBlocks, b.sourceBlocks);
+		}
+	);
+
+	// The copied free blocks still link to the blocks of the source.
+	for (int32 i = 0; i < b2_blockSizes; ++i)
+	{
+		m_freeLists[i] = Relocate(source.m_freeLists[i]);
+
+		for (b2Block* block = m_freeLists[i]; block; block = block->next)
+		{
+			block->next = Relocate(block->next);
+		}
+	}
+
+#if DEBUG_PHYSICS_WORLD_CACHE_COPY
+	m_numAllocatedObjects = source.m_numAllocatedObjects;
+#endif
+}
+
+void* b2BlockAllocator::Relocate(const void* p) const
+{
+	if (p == NULL)
+	{
+		return NULL;
+	}
+
+	const int8* const bytes = (const int8*)p;
+
+	auto it = std::upper_bound(
+		m_relocations.begin(),
+		m_relocations.end(),
+		bytes,
+		[](const int8* b, const b2ChunkRelocation& r)
+		{
+			return std::less<const int8*>()(b, r.sourceBlocks);
+		}
+	);
+
+	// Blocks larger than b2_maxBlockSize are not in any chunk and cannot be relocated.
+	// CloneFrom is only ever called for allocators without them.
+	b2Assert(it != m_relocations.begin());
+	--it;
+
+	const std::ptrdiff_t offset = bytes - it->sourceBlocks;
+	b2Assert(offset < b2_chunkSize);
+
+	return (int8*)m_chunks[it->index].blocks + offset;
+}
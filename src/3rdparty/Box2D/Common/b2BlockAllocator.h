@@ -19,6 +19,8 @@
 #ifndef B2_BLOCK_ALLOCATOR_H
 #define B2_BLOCK_ALLOCATOR_H
 
+#include <vector>
+#include <type_traits>
 #include <Box2D/Common/b2Settings.h>
 #include "augs/build_settings/setting_debug_physics_world_cache_copy.h"
 
@@ -47,17 +49,46 @@ public:
 
 	void Clear();
 
+	/// Make this allocator an exact copy of the source: every chunk is copied as a whole,
+	/// so every block ends up at the same offset within its chunk as in the source.
+	/// The chunks already allocated by this allocator are reused.
+	/// Pointers to the blocks of the source can then be moved over with Relocate.
+	void CloneFrom(const b2BlockAllocator& source);
+
+	/// Number of live allocations larger than b2_maxBlockSize.
+	/// These do not live in any chunk, so they are neither copied by CloneFrom nor can be relocated.
+	int32 GetLargeBlockCount() const { return m_largeBlockCount; }
+
+	/// Translate a pointer to a block of the allocator last passed to CloneFrom
+	/// into the pointer to the same block of this allocator. Null stays null.
+	void* Relocate(const void* p) const;
+
+	template <class T>
+	std::remove_const_t<T>* Relocate(T* p) const {
+		return static_cast<std::remove_const_t<T>*>(Relocate(static_cast<const void*>(p)));
+	}
+
 	b2BlockAllocator& operator=(const b2BlockAllocator&) {
 		return *this;
 	}
 private:
 
+	struct b2ChunkRelocation
+	{
+		const int8* sourceBlocks;
+		int32 index;
+	};
+
 	b2Chunk* m_chunks;
 	int32 m_chunkCount;
 	int32 m_chunkSpace;
+	int32 m_largeBlockCount;
 
 	b2Block* m_freeLists[b2_blockSizes];
 
+	/// Chunks of the last cloned allocator, sorted by address.
+	std::vector<b2ChunkRelocation> m_relocations;
+
 #if DEBUG_PHYSICS_WORLD_CACHE_COPY
 public:
 	unsigned m_numAllocatedObjects;
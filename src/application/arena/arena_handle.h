@@ -1,5 +1,9 @@
 #pragma once
+#include "3rdparty/crc32/crc32.h"
 #include "augs/templates/maybe_const.h"
+#include "augs/readwrite/memory_stream.h"
+#include "augs/readwrite/byte_readwrite_declaration.h"
+#include "augs/readwrite/write_bytes_field_by_field.h"
 #include "application/predefined_rulesets.h"
 #include "application/arena/mode_and_rules.h"
 
@@ -133,6 +137,18 @@ public:
 		return std::visit(std::forward<F>(f), current_mode.state);
 	}
 
+	/* Covers both the solvable and the mode state. Used for desync detection. */
+
+	uint32_t calculate_state_hash() const {
+		thread_local augs::memory_stream ss;
+
+		ss.set_write_pos(0);
+		augs::write_bytes(ss, advanced_cosm.template calculate_solvable_signi_hash<uint32_t>());
+		augs::write_bytes_field_by_field(ss, current_mode.state);
+
+		return crc32buf(reinterpret_cast<char*>(ss.data()), ss.get_write_pos());
+	}
+
 	void load_from(
 		const arena_paths& paths,
 		cosmos_solvable_significant& target_initial_signi
@@ -19,7 +19,7 @@ inline void choose_arena(
 	}
 	else {
 		const auto paths = arena_paths(name);
-		LOG("Solv file: %x", paths.int_paths.solv_file);
+		LOG("Intercosm file: %x", paths.int_paths.binary_file);
 
 		handle.load_from(
 			paths,
@@ -8,6 +8,8 @@ intercosm_paths::intercosm_paths(
 		return target_folder / (intercosm_name + ext);
 	};
 
+	binary_file = in_folder(".int");
+
 	viewables_file = in_folder(".viewables");
 	solv_file = in_folder(".solv");
 	comm_file = in_folder(".comm");
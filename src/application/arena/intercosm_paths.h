@@ -2,6 +2,9 @@
 #include "augs/filesystem/path.h"
 
 struct intercosm_paths {
+	augs::path_type binary_file;
+
+	/* Legacy per-part files, only read when there is no binary file. */
 	augs::path_type viewables_file;
 	augs::path_type comm_file;
 	augs::path_type solv_file;
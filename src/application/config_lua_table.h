@@ -42,6 +42,7 @@
 #include "application/setups/client/lag_compensation_settings.h"
 #include "application/app_intent_type.h"
 #include "application/network/simulation_receiver_settings.h"
+#include "application/main/headless_benchmark.h"
 
 enum class launch_type {
 	// GEN INTROSPECTOR enum class launch_type
@@ -125,6 +126,7 @@ struct config_lua_table {
 	server_start_input default_server_start;
 	server_vars server;
 	augs::dedicated_server_input dedicated_server;
+	headless_benchmark_settings headless_benchmark;
 
 	client_start_input default_client_start;
 	client_vars client;
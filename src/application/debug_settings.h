@@ -13,6 +13,9 @@ struct debug_settings {
 	// GEN INTROSPECTOR struct debug_settings
 	unsigned determinism_test_cloned_cosmoi_count = 0;
 	input_recording_type input_recording_mode = input_recording_type::DISABLED;
+
+	/* Number of samples over which the profilers take their averages and percentiles. */
+	unsigned profiler_window = 256;
 	bool measure_atlas_uploading = false;
 	// END GEN INTROSPECTOR
 };
\ No newline at end of file
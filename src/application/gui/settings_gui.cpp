@@ -553,6 +553,8 @@ void settings_gui_state::perform(
 					auto& scope_cfg = config.editor.player;
 
 					revertable_slider(SCOPE_CFG_NVP(snapshot_interval_in_steps), 400u, 5000u);
+					revertable_slider(SCOPE_CFG_NVP(snapshot_keyframe_interval), 1u, 64u);
+					revertable_slider(SCOPE_CFG_NVP(snapshot_memory_budget_mb), 16u, 8192u);
 				}
 
 				if (auto node = scoped_tree_node("Debug")) {
@@ -642,6 +644,20 @@ void settings_gui_state::perform(
 
 					revertable_slider(SCOPE_CFG_NVP(atlas_blitting_threads), 0u, t_max);
 					revertable_slider(SCOPE_CFG_NVP(neon_regeneration_threads), 0u, t_max);
+					revertable_slider(SCOPE_CFG_NVP(sound_decoding_threads), 0u, t_max);
+				}
+
+				text("Rendering");
+
+				{
+					auto indent = scoped_indent();
+					auto& scope_cfg = config.drawing;
+
+					const auto concurrency = std::thread::hardware_concurrency();
+					const auto t_max = concurrency * 2;
+
+					revertable_slider(SCOPE_CFG_NVP(light_visibility_threads), 0u, t_max);
+					revertable_slider(SCOPE_CFG_NVP(particle_integration_threads), 0u, t_max);
 				}
 
 				break;
@@ -1,3 +1,6 @@
+#include <array>
+#include <cstring>
+
 #include "application/intercosm.h"
 #include "game/cosmos/cosmic_functions.h"
 #include "application/intercosm_io.hpp"
@@ -18,6 +21,7 @@
 
 #include "augs/readwrite/lua_file.h"
 #include "augs/readwrite/byte_file.h"
+#include "augs/filesystem/mapped_file.h"
 
 #include "game/modes/bomb_mode.h"
 #include "game/modes/test_mode.h"
@@ -124,13 +128,182 @@ void intercosm::load_from_lua(const intercosm_path_op op) {
 	augs::load_from_lua_table(op.lua, *this, op.path);
 }
 
+/*
+	The binary intercosm file:
+
+		header | section table | section | section | ...
+
+	The header and the section table are written raw, the sections hold the regular byte serialization of their objects.
+	Every section begins at a multiple of intercosm_section_alignment,
+	so that the trivially copyable containers within - e.g. the entity pools - lie aligned in a mapped file
+	and are read with a single memcpy straight out of the page cache.
+
+	Sections are looked up by their type, so new ones can be appended without breaking older readers.
+	Bump intercosm_file_version whenever the layout of the existing sections changes.
+	Files of other versions are rejected, the arena has to be saved again by a matching build.
+
+		1 - the first binary format.
+		2 - the pools of entity types with soa_components serialize the component columns after the entities.
+*/
+
+namespace {
+	constexpr std::array<char, 8> intercosm_file_magic = { 'H', 'Y', 'P', 'E', 'R', 'I', 'N', 'T' };
+	constexpr uint32_t intercosm_file_version = 2;
+	constexpr std::size_t intercosm_section_alignment = 16;
+
+	enum class intercosm_section_type : uint32_t {
+		VIEWABLES,
+		COMMON_SIGNIFICANT,
+		SOLVABLE_SIGNIFICANT,
+
+		COUNT
+	};
+
+	struct intercosm_file_header {
+		std::array<char, 8> magic = intercosm_file_magic;
+		uint32_t version = intercosm_file_version;
+		uint32_t num_sections = 0;
+	};
+
+	struct intercosm_file_section {
+		intercosm_section_type type = intercosm_section_type::COUNT;
+		uint32_t pad = 0;
+		uint64_t offset = 0;
+		uint64_t size = 0;
+	};
+
+	using intercosm_section_table = std::array<intercosm_file_section, static_cast<std::size_t>(intercosm_section_type::COUNT)>;
+
+	static_assert(std::is_trivially_copyable_v<intercosm_file_header>);
+	static_assert(std::is_trivially_copyable_v<intercosm_file_section>);
+}
+
+std::vector<std::byte> intercosm::to_binary() const {
+	auto scope = measure_scope(world.profiler.serialization_pass);
+
+	/* 
+		Everything is written in a single pass.
+		The header and the section table are only patched in at the end, once the offsets are known.
+	*/
+
+	intercosm_file_header header;
+	intercosm_section_table table;
+
+	augs::memory_stream out;
+	augs::write_bytes(out, header);
+	augs::write_bytes(out, table);
+
+	std::size_t num_sections = 0;
+
+	auto write_section = [&](const intercosm_section_type type, const auto& object) {
+		static constexpr std::array<std::byte, intercosm_section_alignment> zeros = {};
+
+		const auto misalignment = out.get_write_pos() % intercosm_section_alignment;
+
+		if (misalignment != 0) {
+			out.write(zeros.data(), intercosm_section_alignment - misalignment);
+		}
+
+		auto& entry = table[num_sections++];
+
+		entry.type = type;
+		entry.offset = out.get_write_pos();
+
+		augs::write_bytes(out, object);
+
+		entry.size = out.get_write_pos() - entry.offset;
+	};
+
+	write_section(intercosm_section_type::VIEWABLES, viewables);
+	write_section(intercosm_section_type::COMMON_SIGNIFICANT, world.get_common_significant());
+	write_section(intercosm_section_type::SOLVABLE_SIGNIFICANT, world.get_solvable().significant);
+
+	header.num_sections = static_cast<uint32_t>(num_sections);
+
+	std::memcpy(out.data(), &header, sizeof(header));
+	std::memcpy(out.data() + sizeof(header), table.data(), sizeof(table));
+
+	return std::move(out).extract();
+}
+
+void intercosm::load_from_binary(const augs::byte_span& bytes) {
+	auto scope = measure_scope(world.profiler.deserialization_pass);
+
+	intercosm_file_header header;
+
+	if (bytes.size() < sizeof(header)) {
+		throw intercosm_file_error("The intercosm file is too small (%x bytes).", bytes.size());
+	}
+
+	std::memcpy(&header, bytes.data(), sizeof(header));
+
+	if (header.magic != intercosm_file_magic) {
+		throw intercosm_file_error("Not an intercosm file.");
+	}
+
+	if (header.version != intercosm_file_version) {
+		throw intercosm_file_error("Unsupported intercosm file version: %x (expected %x).", header.version, intercosm_file_version);
+	}
+
+	const auto table_size = std::size_t(header.num_sections) * sizeof(intercosm_file_section);
+
+	if (bytes.size() < sizeof(header) + table_size) {
+		throw intercosm_file_error("The section table of the intercosm file is truncated.");
+	}
+
+	auto find_section = [&](const intercosm_section_type type) {
+		for (uint32_t i = 0; i < header.num_sections; ++i) {
+			intercosm_file_section entry;
+			std::memcpy(&entry, bytes.data() + sizeof(header) + i * sizeof(entry), sizeof(entry));
+
+			if (entry.type == type) {
+				if (entry.offset > bytes.size() || entry.size > bytes.size() - entry.offset) {
+					throw intercosm_file_error("Section %x of the intercosm file is out of bounds.", static_cast<uint32_t>(type));
+				}
+
+				return augs::byte_span { bytes.data() + entry.offset, static_cast<std::size_t>(entry.size) };
+			}
+		}
+
+		throw intercosm_file_error("The intercosm file lacks section %x.", static_cast<uint32_t>(type));
+	};
+
+	auto read_section = [&](const intercosm_section_type type, auto& object) {
+		const auto section = find_section(type);
+		auto in = augs::span_memory_stream(section);
+
+		augs::read_bytes(in, object);
+	};
+
+	read_section(intercosm_section_type::VIEWABLES, viewables);
+
+	world.change_common_significant([&](cosmos_common_significant& common) {
+		read_section(intercosm_section_type::COMMON_SIGNIFICANT, common);
+		return changer_callback_result::DONT_REFRESH;
+	});
+
+	cosmic::change_solvable_significant(world, [&](cosmos_solvable_significant& significant) {
+		read_section(intercosm_section_type::SOLVABLE_SIGNIFICANT, significant);
+		return changer_callback_result::DONT_REFRESH;
+	});
+
+	post_load_state_correction();
+}
+
 void intercosm::save_as_bytes(const intercosm_paths& paths) const {
-	augs::save_as_bytes(viewables, paths.viewables_file);
-	augs::save_as_bytes(world.get_common_significant(), paths.comm_file);
-	augs::save_as_bytes(world.get_solvable().significant, paths.solv_file);
+	augs::save_as_bytes(to_binary(), paths.binary_file);
 }
 
 void intercosm::load_from_bytes(const intercosm_paths& paths) {
+	if (augs::exists(paths.binary_file)) {
+		const auto file = augs::mapped_file(paths.binary_file);
+		load_from_binary({ file.data(), file.size() });
+
+		return;
+	}
+
+	/* Arenas saved before the binary format existed. */
+
 	augs::load_from_bytes(viewables, paths.viewables_file);
 
 	world.change_common_significant([&](cosmos_common_significant& common) {
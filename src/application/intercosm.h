@@ -1,5 +1,7 @@
 #pragma once
 #include "augs/enums/callback_result.h"
+#include "augs/templates/exception_templates.h"
+#include "augs/readwrite/memory_stream_declaration.h"
 #include "game/assets/all_logical_assets.h"
 #include "game/cosmos/cosmos.h"
 #include "view/viewables/all_viewables_defs.h"
@@ -16,6 +18,10 @@ struct intercosm_path_op {
 
 struct test_scene_settings;
 
+struct intercosm_file_error : error_with_typesafe_sprintf {
+	using error_with_typesafe_sprintf::error_with_typesafe_sprintf;
+};
+
 struct test_mode_ruleset;
 struct bomb_mode_ruleset;
 
@@ -42,6 +48,9 @@ struct intercosm {
 	void load_from_bytes(const intercosm_paths&);
 	void save_as_bytes(const intercosm_paths&) const;
 
+	std::vector<std::byte> to_binary() const;
+	void load_from_binary(const augs::byte_span&);
+
 	void load_from_lua(const intercosm_path_op);
 	void save_as_lua(const intercosm_path_op) const;
 
@@ -12,27 +12,14 @@
 namespace augs {
 	template <class Archive>
 	void write_object_bytes(Archive& into, const cosmos& cosm) {
-		auto& profiler = cosm.profiler;
-
-		if constexpr(can_reserve_v<Archive>) {
-			augs::byte_counter_stream counter_stream;
-
-			{
-				auto scope = measure_scope(profiler.size_calculation_pass);
-				augs::write_bytes(counter_stream, cosm.get_common_significant());
-				augs::write_bytes(counter_stream, cosm.get_solvable().significant);
-			}
-
-			auto scope = measure_scope(profiler.memory_allocation_pass);
-			
-			into.reserve(into.get_write_pos() + counter_stream.size());
-		}
-
-		{
-			auto scope = measure_scope(profiler.serialization_pass);
-			augs::write_bytes(into, cosm.get_common_significant());
-			augs::write_bytes(into, cosm.get_solvable().significant);
-		}
+		/*
+			A single pass. Memory streams grow geometrically,
+			which is cheaper than serializing everything twice just to learn the size up front.
+		*/
+
+		auto scope = measure_scope(cosm.profiler.serialization_pass);
+		augs::write_bytes(into, cosm.get_common_significant());
+		augs::write_bytes(into, cosm.get_solvable().significant);
 	}
 
 	/* 
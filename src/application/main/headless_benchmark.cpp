@@ -0,0 +1,259 @@
+#include <limits>
+#include <iterator>
+#include <algorithm>
+
+#include "augs/log.h"
+#include "augs/filesystem/file.h"
+#include "augs/readwrite/byte_file.h"
+#include "augs/misc/randomization.h"
+#include "augs/misc/measurements.h"
+#include "augs/string/typesafe_sprintf.h"
+
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/solvers/solve_structs.h"
+#include "game/cosmos/solvers/solver_callbacks.h"
+
+#include "application/intercosm.h"
+#include "application/predefined_rulesets.h"
+#include "application/network/network_common.h"
+#include "application/setups/server/server_vars.h"
+#include "application/arena/arena_utils.h"
+#include "application/arena/arena_handle.h"
+#include "application/arena/choose_arena.h"
+
+#include "application/main/headless_benchmark.h"
+
+namespace {
+	struct benchmark_arena {
+		intercosm scene;
+		cosmos_solvable_significant initial_signi;
+		predefined_rulesets rulesets;
+		online_mode_and_rules current_mode;
+
+		online_arena_handle<false> get_handle() {
+			return { current_mode, scene, scene.world, rulesets, initial_signi };
+		}
+	};
+
+	/*
+		Players join one per step, like they would on a server.
+		Once they have a character, they randomly press and release the movement and shooting buttons,
+		and move the crosshair around.
+	*/
+
+	class random_entropy_source {
+		randomization rng;
+		unsigned num_players;
+
+		static constexpr game_intent_type random_intents[] = {
+			game_intent_type::MOVE_FORWARD,
+			game_intent_type::MOVE_BACKWARD,
+			game_intent_type::MOVE_LEFT,
+			game_intent_type::MOVE_RIGHT,
+			game_intent_type::SPRINT,
+			game_intent_type::CROSSHAIR_PRIMARY_ACTION,
+			game_intent_type::RELOAD
+		};
+
+	public:
+		random_entropy_source(const rng_seed_type seed, const unsigned num_players)
+			: rng(seed), num_players(num_players)
+		{}
+
+		mode_entropy next(const online_arena_handle<false> arena, const unsigned step) {
+			mode_entropy entropy;
+
+			if (step < num_players) {
+				entropy.general.added_player = add_player_input {
+					mode_player_id(step),
+					typesafe_sprintf("Player%x", step),
+					faction_type::DEFAULT
+				};
+			}
+
+			for (unsigned i = 0; i < std::min(step, num_players); ++i) {
+				const auto character = arena.on_mode(
+					[&](const auto& typed_mode) {
+						return typed_mode.lookup(mode_player_id(i));
+					}
+				);
+
+				if (!character.is_set()) {
+					continue;
+				}
+
+				auto& player = entropy.cosmic[character];
+
+				if (rng.randval(0, 7) == 0) {
+					game_intent intent;
+					intent.intent = random_intents[rng.randval(std::size_t(0), std::size(random_intents) - 1)];
+					intent.change = rng.randval(0, 1) ? intent_change::PRESSED : intent_change::RELEASED;
+
+					player.intents.push_back(intent);
+				}
+
+				player.motions[game_motion_type::MOVE_CROSSHAIR] = vec2(rng.randval(-20.f, 20.f), rng.randval(-20.f, 20.f));
+			}
+
+			return entropy;
+		}
+	};
+
+	void append_time(std::string& json, const augs::time_measurements& m) {
+		json += typesafe_sprintf(
+			"{ \"avg_ms\": %f3, \"p50_ms\": %f3, \"p95_ms\": %f3, \"p99_ms\": %f3, \"max_ms\": %f3 }",
+			m.get_average_units() * 1000,
+			m.get_percentile_units(0.5) * 1000,
+			m.get_percentile_units(0.95) * 1000,
+			m.get_percentile_units(0.99) * 1000,
+			m.get_maximum_units() * 1000
+		);
+	}
+}
+
+void run_headless_benchmark(sol::state& lua, const headless_benchmark_settings& settings) {
+	/* Intercosm is too big for the stack. */
+	const auto arena = std::make_unique<benchmark_arena>();
+	const auto handle = arena->get_handle();
+
+	{
+		server_vars vars;
+		vars.current_arena = settings.arena;
+
+		choose_arena(lua, handle, vars, arena->initial_signi);
+	}
+
+	auto& cosm = handle.get_cosmos();
+
+	const auto& entropy_path = settings.recorded_entropy_path;
+	const bool replaying = !entropy_path.empty() && augs::exists(entropy_path);
+
+	std::vector<mode_entropy> recorded;
+
+	if (replaying) {
+		augs::load_from_bytes(recorded, entropy_path);
+		LOG("Replaying %x recorded entropies from %x.", recorded.size(), entropy_path);
+	}
+
+	random_entropy_source random_entropy(
+		static_cast<rng_seed_type>(settings.rng_seed),
+		std::min(settings.num_players, static_cast<unsigned>(max_incoming_connections_v))
+	);
+
+	/* So that the percentiles cover the whole run and not only the last steps. */
+	const auto window = std::clamp(settings.num_steps, 1u, static_cast<unsigned>(std::numeric_limits<unsigned short>::max()));
+
+	cosm.profiler.set_window_of_measurements(window);
+
+	augs::time_measurements step_time = window;
+
+	std::size_t total_raycasts = 0;
+	std::size_t visibility_raycasts = 0;
+	std::size_t pathfinding_raycasts = 0;
+
+	auto step_settings = solve_settings();
+	step_settings.num_additional_workers = settings.num_additional_workers;
+
+	LOG("Advancing %x entities by %x steps.", cosm.get_entities_count(), settings.num_steps);
+
+	for (unsigned step = 0; step < settings.num_steps; ++step) {
+		auto entropy = [&]() {
+			if (replaying) {
+				return step < recorded.size() ? recorded[step] : mode_entropy();
+			}
+
+			return random_entropy.next(handle, step);
+		}();
+
+		if (!replaying && !entropy_path.empty()) {
+			recorded.push_back(entropy);
+		}
+
+		{
+			auto scope = measure_scope(step_time);
+			handle.advance(std::move(entropy), solver_callbacks(), step_settings);
+		}
+
+		const auto& p = cosm.profiler;
+
+		total_raycasts += p.total_step_raycasts.get_last_measurement_units();
+		visibility_raycasts += p.visibility_raycasts.get_last_measurement_units();
+		pathfinding_raycasts += p.pathfinding_raycasts.get_last_measurement_units();
+	}
+
+	if (!replaying && !entropy_path.empty()) {
+		augs::save_as_bytes(recorded, entropy_path);
+		LOG("Recorded %x entropies to %x.", recorded.size(), entropy_path);
+	}
+
+	const auto state_hash = handle.calculate_state_hash();
+
+	std::string json = "{\n";
+
+	json += typesafe_sprintf("  \"arena\": \"%x\",\n", settings.arena);
+	json += typesafe_sprintf("  \"entropy\": \"%x\",\n", replaying ? "recorded" : "random");
+	json += typesafe_sprintf("  \"steps\": %x,\n", settings.num_steps);
+	json += typesafe_sprintf("  \"additional_workers\": %x,\n", settings.num_additional_workers);
+	json += typesafe_sprintf("  \"entities\": %x,\n", cosm.get_entities_count());
+	json += typesafe_sprintf("  \"state_hash\": %x,\n", state_hash);
+
+	json += typesafe_sprintf(
+		"  \"raycasts\": { \"total\": %x, \"visibility\": %x, \"pathfinding\": %x },\n",
+		total_raycasts,
+		visibility_raycasts,
+		pathfinding_raycasts
+	);
+
+	json += "  \"step\": ";
+	append_time(json, step_time);
+	json += ",\n";
+
+	json += "  \"systems\": {";
+
+	bool first = true;
+
+	cosm.profiler.for_each_measurement(
+		[&](const auto& label, const auto& m) {
+			using T = remove_cref<decltype(m)>;
+
+			if constexpr(std::is_same_v<T, augs::time_measurements>) {
+				if (!m.was_measured()) {
+					return;
+				}
+
+				json += first ? "\n" : ",\n";
+				json += typesafe_sprintf("    \"%x\": ", label);
+				append_time(json, m);
+
+				first = false;
+			}
+		}
+	);
+
+	json += "\n  },\n";
+
+	json += "  \"stage_critical_paths\": {";
+
+	first = true;
+
+	for (const auto& m : cosm.profiler.solve_stages) {
+		json += first ? "\n" : ",\n";
+		json += typesafe_sprintf("    \"%x\": ", m.title);
+		append_time(json, m);
+
+		first = false;
+	}
+
+	json += "\n  }\n}\n";
+
+	const auto output_path = settings.output_path.empty() ? augs::path_type(LOG_FILES_DIR "/headless_benchmark.json") : settings.output_path;
+
+	augs::save_as_text(output_path, json);
+
+	LOG(
+		"Step: %x ms on average. State hash: %x. Results written to %x.",
+		step_time.get_average_units() * 1000,
+		state_hash,
+		output_path
+	);
+}
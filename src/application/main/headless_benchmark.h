@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include "3rdparty/sol2/sol/forward.hpp"
+#include "augs/filesystem/path.h"
+
+struct headless_benchmark_settings {
+	// GEN INTROSPECTOR struct headless_benchmark_settings
+	/* Empty means the default test arena. */
+	std::string arena;
+
+	unsigned num_steps = 3000;
+	unsigned num_players = 8;
+	unsigned rng_seed = 0;
+	unsigned num_additional_workers = 0;
+
+	/*
+		If the file exists, the entropies are replayed from it.
+		Otherwise the random entropies are recorded into it, so that the next runs can replay them.
+	*/
+
+	augs::path_type recorded_entropy_path = "";
+	augs::path_type output_path = "";
+	// END GEN INTROSPECTOR
+};
+
+/*
+	Advances an arena for a number of steps without a window, audio or rendering,
+	then writes the per-system timings, raycast counts and the final state hash as JSON.
+*/
+
+void run_headless_benchmark(sol::state& lua, const headless_benchmark_settings&);
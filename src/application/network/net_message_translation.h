@@ -1,16 +1,24 @@
 #pragma once
+#include "3rdparty/crc32/crc32.h"
 #include "augs/readwrite/memory_stream.h"
 #include "augs/misc/serialization_buffers.h"
 #include "augs/misc/compress.h"
+#include "augs/readwrite/delta_compression.h"
 #include "augs/misc/readable_bytesize.h"
 #include "augs/templates/logically_empty.h"
 #include "application/network/net_serialization_helpers.h"
+#include "application/network/network_common.h"
 
 template <bool C>
 struct initial_arena_state_payload {
 	maybe_const_ref_t<C, cosmos_solvable_significant> signi;
 	maybe_const_ref_t<C, online_mode_and_rules> mode;
 	maybe_const_ref_t<C, uint32_t> client_id;
+
+	const initial_arena_baseline& baseline;
+
+	/* Set when the state was sent as a delta against a baseline other than ours. */
+	maybe_const_ref_t<C, bool> baseline_mismatch;
 };
 
 using ref_net_stream = augs::basic_ref_memory_stream<message_bytes_type>;
@@ -47,6 +55,13 @@ namespace net_messages {
 	template <class Stream>
 	bool serialize(Stream& s, ::prestep_client_context& c) {
 		serialize_int(s, c.num_entropies_accepted, 0, 255);
+
+		/* 
+			The context must end on a byte boundary 
+			so that the preserialized remainder of a step can be simply appended after it.
+		*/
+
+		serialize_align(s);
 		return true;
 	}
 
@@ -246,16 +261,10 @@ namespace net_messages {
 	}
 
 	template <class Stream>
-	bool serialize(Stream& s, ::networked_server_step_entropy& total_networked) {
+	bool serialize_shared(Stream& s, ::networked_server_step_entropy& total_networked) {
 		auto& i = total_networked.payload;
 		auto& g = i.general;
 
-#if !CONTEXTS_SEPARATE
-		if (!serialize(s, total_networked.context)) {
-			return false;
-		}
-#endif
-
 		auto& state_hash = total_networked.meta.state_hash;
 		bool has_state_hash = logically_set(state_hash);
 
@@ -328,6 +337,17 @@ namespace net_messages {
 		return true;
 	}
 
+	template <class Stream>
+	bool serialize(Stream& s, ::networked_server_step_entropy& total_networked) {
+#if !CONTEXTS_SEPARATE
+		if (!serialize(s, total_networked.context)) {
+			return false;
+		}
+#endif
+
+		return serialize_shared(s, total_networked);
+	}
+
 	template <class B, class T>
 	bool safe_write(B& bytes, T& payload) {
 		auto s = yojimbo::WriteStream(yojimbo::GetDefaultAllocator(), (uint8_t*)bytes.data(), bytes.size());
@@ -369,6 +389,63 @@ namespace net_messages {
 		return safe_write(bytes, input);
 	}
 
+	inline bool preserialize(
+		preserialized_server_step_entropy& output,
+		::networked_server_step_entropy& input
+	) {
+		auto& bytes = output.bytes;
+		bytes.resize(max_server_step_size_v);
+
+		auto s = yojimbo::WriteStream(yojimbo::GetDefaultAllocator(), (uint8_t*)bytes.data(), bytes.size());
+
+		if (!serialize_shared(s, input)) {
+			return false;
+		}
+
+		s.Flush();
+		bytes.resize(s.GetBytesProcessed());
+
+		return true;
+	}
+
+	inline bool server_step_entropy::write_payload(
+		const ::prestep_client_context& context,
+		const preserialized_server_step_entropy& shared
+	) {
+#if CONTEXTS_SEPARATE
+		(void)context;
+		bytes = shared.bytes;
+#else
+		/* 
+			The bitpacker writes little-endian words, 
+			so a byte-aligned context followed by the preserialized bytes
+			is exactly what a single pass over the whole entropy would produce.
+		*/
+
+		bytes.resize(sizeof(uint32_t));
+
+		{
+			auto s = yojimbo::WriteStream(yojimbo::GetDefaultAllocator(), (uint8_t*)bytes.data(), bytes.size());
+			auto written_context = context;
+
+			if (!serialize(s, written_context)) {
+				return false;
+			}
+
+			s.Flush();
+			bytes.resize(s.GetBytesProcessed());
+		}
+
+		if (bytes.size() + shared.bytes.size() > max_server_step_size_v) {
+			return false;
+		}
+
+		bytes.insert(bytes.end(), shared.bytes.begin(), shared.bytes.end());
+#endif
+
+		return true;
+	}
+
 	inline bool client_entropy::read_payload(
 		total_client_entropy& output
 	) {
@@ -425,6 +502,30 @@ namespace net_messages {
 		return unsafe_write_message(*this, input);
 	}
 
+	/*
+		The initial state block begins with the recipient's client id, the uncompressed size
+		and the hash of the arena baseline the state was encoded against, or zero if it was not.
+	*/
+
+	constexpr auto initial_arena_state_header_size = sizeof(uint32_t) * 3;
+	constexpr auto max_initial_arena_state_size = 100 * 1024 * 1024;
+
+	inline initial_arena_baseline make_initial_arena_baseline(const cosmos_solvable_significant& signi) {
+		initial_arena_baseline result;
+
+		{
+			auto s = augs::ref_memory_stream(result.bytes);
+			augs::write_bytes(s, signi);
+		}
+
+		const auto hash = crc32buf(reinterpret_cast<char*>(result.bytes.data()), result.bytes.size());
+
+		/* Zero is reserved for "no baseline". */
+		result.hash = std::max(hash, uint32_t(1));
+
+		return result;
+	}
+
 	inline bool initial_arena_state::read_payload(
 		augs::serialization_buffers& buffers,
 		const initial_arena_state_payload<false> in
@@ -436,19 +537,34 @@ namespace net_messages {
 
 		NSR_LOG("Compressed stream size: %x", size);
 
-		if (size < sizeof(uint32_t)) {
+		constexpr auto header_size = initial_arena_state_header_size;
+
+		in.baseline_mismatch = false;
+
+		if (size < header_size) {
 			return false;
 		}
 
-		const auto uncompressed_size = *reinterpret_cast<const uint32_t*>(data);
+		in.client_id = reinterpret_cast<const uint32_t*>(data)[0];
+		const auto uncompressed_size = reinterpret_cast<const uint32_t*>(data)[1];
+		const auto baseline_hash = reinterpret_cast<const uint32_t*>(data)[2];
 	
+		NSR_LOG_NVPS(in.client_id);
 		NSR_LOG("Uncompressed size: %x", uncompressed_size);
+		NSR_LOG("Baseline hash: %x", baseline_hash);
+
+		if (baseline_hash != 0 && baseline_hash != in.baseline.hash) {
+			LOG("The initial state was encoded against a different arena (hash: %x, ours: %x).", baseline_hash, in.baseline.hash);
+
+			in.baseline_mismatch = true;
+			return false;
+		}
 
 		/*
 			TODO: validate uncompressed_size with some predefined max solvable size.
 		*/
 
-		if (uncompressed_size > 100 * 1024 * 1024) {
+		if (uncompressed_size > max_initial_arena_state_size) {
 			return false;
 		}
 
@@ -457,8 +573,8 @@ namespace net_messages {
 
 		try {
 			augs::decompress(
-				data + sizeof(uint32_t),
-				size - sizeof(uint32_t),
+				data + header_size,
+				size - header_size,
 				uncompressed_buf
 			);
 
@@ -471,47 +587,103 @@ namespace net_messages {
 			return false;
 		}
 
-		auto s = augs::cref_memory_stream(uncompressed_buf);
+		try {
+			auto s = augs::cref_memory_stream(uncompressed_buf);
 
-		augs::read_bytes(s, in.signi);
-		augs::read_bytes(s, in.mode);
-		augs::read_bytes(s, in.client_id);
+			if (baseline_hash == 0) {
+				augs::read_bytes(s, in.signi);
+			}
+			else {
+				auto& patched_signi = buffers.compressed;
 
-		NSR_LOG_NVPS(in.client_id);
+				augs::read_bytes_delta(in.baseline.bytes, s, patched_signi, max_initial_arena_state_size);
+
+				NSR_LOG("Patched the baseline into %x bytes.", patched_signi.size());
+
+				auto ps = augs::cref_memory_stream(patched_signi);
+				augs::read_bytes(ps, in.signi);
+			}
+
+			augs::read_bytes(s, in.mode);
+		}
+		catch (const augs::stream_read_error& err) {
+			LOG("Failed to read the initial state. Server might be malicious.");
+			LOG(err.what());
+
+			return false;
+		}
 
 		return true;
 	}
 
-	inline const std::vector<std::byte>* initial_arena_state::write_payload(
+	/*
+		Pass a baseline without a hash to always send the whole state,
+		e.g. to the clients whose arena files differ from ours.
+	*/
+
+	inline void preserialize(
 		augs::serialization_buffers& buffers,
-		const initial_arena_state_payload<true> in
+		preserialized_initial_arena_state& output,
+		const cosmos_solvable_significant& signi,
+		const online_mode_and_rules& mode,
+		const initial_arena_baseline& baseline
 	) {
-		auto write_all_to = [&in](auto& s) {
-			augs::write_bytes(s, in.signi);
-			augs::write_bytes(s, in.mode);
-			augs::write_bytes(s, in.client_id);
-		};
+		NSR_LOG("PRESERIALIZING INITIAL STATE");
 
-		NSR_LOG("SENDING INITIAL STATE");
+		auto& serialized = buffers.serialization;
 
 		{
 			NSR_LOG("STAGE: ESTIMATION");
 
 			augs::byte_counter_stream s;
-			write_all_to(s);
-			buffers.serialization.reserve(s.size());
+			augs::write_bytes(s, signi);
+			augs::write_bytes(s, mode);
+			serialized.reserve(s.size());
 
 			NSR_LOG("Reserved size: %x", s.size());
 
 			{
 				auto s = buffers.make_serialization_stream();
-				write_all_to(s);
+				augs::write_bytes(s, signi);
 			}
+		}
+
+		auto baseline_hash = baseline.hash;
+
+		if (baseline_hash != 0) {
+			NSR_LOG("STAGE: DELTA");
+
+			/*
+				Most of the arena is usually untouched since it was loaded,
+				but if the delta ends up no smaller than the state itself, the state is sent as is.
+			*/
 
-			NSR_LOG("Result stream length: %x", buffers.serialization.size());
+			auto& delta = buffers.compressed;
+			delta.clear();
+
+			{
+				auto s = augs::ref_memory_stream(delta);
+				augs::write_bytes_delta(baseline.bytes, serialized, s);
+			}
+
+			NSR_LOG("Delta size: %x, full size: %x", delta.size(), serialized.size());
+
+			if (delta.size() < serialized.size()) {
+				std::swap(delta, serialized);
+			}
+			else {
+				baseline_hash = 0;
+			}
 		}
 
-		auto& c = buffers.compressed;
+		{
+			auto s = augs::ref_memory_stream(serialized);
+			augs::write_bytes(s, mode);
+		}
+
+		NSR_LOG("Result stream length: %x", serialized.size());
+
+		auto& c = output.bytes;
 
 		{
 			NSR_LOG("STAGE: COMPRESSION");
@@ -520,16 +692,35 @@ namespace net_messages {
 
 			{
 				auto s = augs::ref_memory_stream(c);
-				const auto uncompressed_size = static_cast<uint32_t>(buffers.serialization.size());
+				const auto recipient_placeholder = uint32_t(0);
+				const auto uncompressed_size = static_cast<uint32_t>(serialized.size());
+
+				augs::write_bytes(s, recipient_placeholder);
 				augs::write_bytes(s, uncompressed_size);
+				augs::write_bytes(s, baseline_hash);
 
 				NSR_LOG("Uncompressed size: %x", uncompressed_size);
 			}
 
-			augs::compress(buffers.compression_state, buffers.serialization, c);
+			augs::compress(buffers.compression_state, serialized, c);
 
 			NSR_LOG("Compressed stream size: %x", c.size());
 		}
+	}
+
+	inline const std::vector<std::byte>* initial_arena_state::write_payload(
+		preserialized_initial_arena_state& preserialized,
+		const uint32_t client_id
+	) {
+		NSR_LOG("SENDING INITIAL STATE");
+
+		auto& c = preserialized.bytes;
+
+		if (c.size() < initial_arena_state_header_size) {
+			return nullptr;
+		}
+
+		std::memcpy(c.data(), &client_id, sizeof(client_id));
 
 		return std::addressof(c);
 	}
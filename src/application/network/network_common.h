@@ -3,5 +3,27 @@
 
 using server_step_type = uint32_t;
 
+/*
+	Compressed initial arena state, shared by all clients that join or resync during the same step.
+	The leading recipient id is left uncompressed so that it can be patched in right before sending.
+*/
+
+struct preserialized_initial_arena_state {
+	std::vector<std::byte> bytes;
+};
+
+/*
+	The serialized significant state of the current arena, exactly as it was loaded from the arena files.
+
+	The server and its clients load the same arena on their own,
+	so the initial state can be sent as a delta against this baseline.
+	The hash tells whether the baselines match. Zero means there is no baseline.
+*/
+
+struct initial_arena_baseline {
+	std::vector<std::byte> bytes;
+	uint32_t hash = 0;
+};
+
 template <bool C>
 using online_arena_handle = basic_arena_handle<C, online_mode_and_rules>;
@@ -41,6 +41,15 @@ using message_bytes_type = augs::constant_size_vector<std::byte, max_message_siz
 
 struct server_vars;
 
+/*
+	Everything of a networked_server_step_entropy except the per-client context.
+	Serialized once per step and then copied into the message of every client.
+*/
+
+struct preserialized_server_step_entropy {
+	message_bytes_type bytes;
+};
+
 struct preserialized_message : public yojimbo::Message {
 	message_bytes_type bytes;
 
@@ -74,6 +83,8 @@ struct only_block_message : public yojimbo::BlockMessage {
 template <bool C>
 struct initial_arena_state_payload;
 
+struct preserialized_initial_arena_state;
+
 namespace net_messages {
 	struct client_welcome : public yojimbo::Message {
 		static constexpr bool server_to_client = false;
@@ -120,8 +131,8 @@ namespace net_messages {
 		);
 
 		const std::vector<std::byte>* write_payload(
-			augs::serialization_buffers&,
-			initial_arena_state_payload<true>
+			preserialized_initial_arena_state&,
+			uint32_t client_id
 		);
 	};
 
@@ -149,6 +160,7 @@ namespace net_messages {
 		static constexpr bool client_to_server = false;
 
 		bool write_payload(::networked_server_step_entropy&);
+		bool write_payload(const ::prestep_client_context&, const preserialized_server_step_entropy&);
 		bool read_payload(::networked_server_step_entropy&);
 
 		using yojimbo::Message::Acquire;
@@ -173,7 +173,7 @@ public:
 #endif
 
 						const auto client_state_hash = 
-							referential_cosmos.template calculate_solvable_signi_hash<uint32_t>()
+							referential_arena.calculate_state_hash()
 						;
 
 						if (*received_hash != client_state_hash) {
@@ -5,6 +5,9 @@ enum class special_client_request {
 
 	RESYNC,
 
+	/* Our arena files differ from the server's, so a delta against them is useless. */
+	RESYNC_WHOLE_STATE,
+
 	COUNT
 };
 
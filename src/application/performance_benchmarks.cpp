@@ -0,0 +1,1068 @@
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <thread>
+#include <optional>
+#include <Catch/single_include/catch2/catch.hpp>
+
+#include "augs/log.h"
+#include "augs/misc/timing/timer.h"
+#include "augs/misc/lua/lua_utils.h"
+#include "augs/misc/randomization.h"
+#include "augs/filesystem/directory.h"
+#include "augs/readwrite/byte_file.h"
+#include "augs/misc/paged_vector.h"
+#include "augs/misc/pool/column_pool_allocate.h"
+#include "augs/readwrite/memory_stream.h"
+#include "3rdparty/crc32/crc32.h"
+
+#include "game/enums/filters.h"
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/cosmos/create_entity.hpp"
+#include "game/cosmos/change_common_significant.hpp"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "game/organization/all_component_includes.h"
+#include "game/stateless_systems/visibility_system.h"
+#include "game/modes/test_mode.h"
+
+#include "view/viewables/image_definition.h"
+#include "view/audiovisual_state/systems/particles_simulation_system.h"
+#include "view/audiovisual_state/systems/interpolation_system.h"
+#include "view/audiovisual_state/systems/randomizing_system.h"
+#include "view/audiovisual_state/systems/static_batch_system.h"
+#include "view/viewables/images_in_atlas_map.h"
+#include "view/rendering_scripts/draw_entity.h"
+
+#include "application/intercosm.h"
+#include "application/arena/arena_paths.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+
+/*
+	Benchmarks are tagged as hidden so that they do not slow down the unit tests ran on startup.
+	Run them explicitly with the "[.benchmark]" tag.
+*/
+
+namespace {
+	auto make_testbed() {
+		auto lua = augs::create_lua_state();
+
+		/* Intercosm is too big for the stack. */
+		auto scene = std::make_unique<intercosm>();
+		test_mode_ruleset ruleset;
+
+		scene->make_test_scene(lua, { false, 60 }, ruleset);
+		return scene;
+	}
+
+	template <class P>
+	auto measure_pool_cloning(const std::size_t num_entities) {
+		const auto num_passes = 100;
+
+		/* Statically allocated pools are too big for the stack. */
+		const auto source = std::make_unique<P>();
+		const auto target = std::make_unique<P>();
+
+		for (std::size_t i = 0; i < num_entities; ++i) {
+			source->allocate(raw_entity_flavour_id(), augs::stepped_timestamp());
+		}
+
+		augs::timer t;
+
+		for (int i = 0; i < num_passes; ++i) {
+			*target = *source;
+		}
+
+		REQUIRE(target->size() == num_entities);
+
+		return t.get<std::chrono::microseconds>() / num_passes;
+	}
+}
+
+TEST_CASE("Benchmark VisibilityScaling", "[.benchmark]") {
+	const auto scene = make_testbed();
+	const auto& cosm = scene->world;
+
+	visibility_requests requests;
+
+	cosm.for_each_having<components::light>(
+		[&](const auto light_entity) {
+			messages::visibility_information_request request;
+			request.eye_transform = light_entity.get_logic_transform();
+			request.filter = predefined_queries::line_of_sight();
+			request.queried_rect = light_entity.template get<components::light>().calc_reach_trimmed();
+			request.subject = light_entity;
+
+			requests.emplace_back(std::move(request));
+		}
+	);
+
+	cosm.for_each_having<components::sentience>(
+		[&](const auto sentient) {
+			messages::visibility_information_request request;
+			request.eye_transform = sentient.get_logic_transform();
+			request.filter = predefined_queries::line_of_sight();
+			request.queried_rect = vec2(1920, 1080);
+			request.subject = sentient;
+
+			requests.emplace_back(std::move(request));
+		}
+	);
+
+	REQUIRE(requests.size() > 1);
+
+	const auto num_passes = 100;
+	std::vector<debug_line> lines;
+
+	visibility_responses serial_responses;
+	visibility_responses parallel_responses;
+
+	auto run = [&](const std::size_t num_additional_workers, visibility_responses& responses) {
+		augs::timer t;
+
+		for (int i = 0; i < num_passes; ++i) {
+			visibility_system(lines, num_additional_workers).calc_visibility(cosm, requests, responses);
+		}
+
+		return t.get<std::chrono::microseconds>() / num_passes;
+	};
+
+	const auto serial_us = run(0, serial_responses);
+	LOG("Visibility of %x requests. Serial: %x us", requests.size(), serial_us);
+
+	const auto max_threads = std::max(2u, std::thread::hardware_concurrency());
+
+	for (unsigned num_threads = 1; num_threads <= max_threads; ++num_threads) {
+		const auto parallel_us = run(num_threads - 1, parallel_responses);
+
+		LOG("Threads: %x, time: %x us, speedup: %x", num_threads, parallel_us, serial_us / parallel_us);
+
+		for (std::size_t i = 0; i < requests.size(); ++i) {
+			const auto& s = serial_responses[i];
+			const auto& p = parallel_responses[i];
+			const auto eye = requests[i].eye_transform.pos;
+
+			REQUIRE(s.source_queried_rect == p.source_queried_rect);
+			REQUIRE(s.edges == p.edges);
+			REQUIRE(s.vertex_hits == p.vertex_hits);
+			REQUIRE(s.marked_holes == p.marked_holes);
+			REQUIRE(s.get_world_polygon(0.f, eye, 0.f) == p.get_world_polygon(0.f, eye, 0.f));
+
+			REQUIRE(s.discontinuities.size() == p.discontinuities.size());
+
+			for (std::size_t d = 0; d < s.discontinuities.size(); ++d) {
+				const auto& sd = s.discontinuities[d];
+				const auto& pd = p.discontinuities[d];
+
+				REQUIRE(sd.edge_index == pd.edge_index);
+				REQUIRE(sd.is_boundary == pd.is_boundary);
+				REQUIRE(sd.normal == pd.normal);
+				REQUIRE(sd.points == pd.points);
+				REQUIRE(sd.last_undiscovered_wall == pd.last_undiscovered_wall);
+				REQUIRE(sd.winding == pd.winding);
+			}
+		}
+	}
+}
+
+TEST_CASE("Benchmark StateHash", "[.benchmark]") {
+	const auto scene = make_testbed();
+	auto& cosm = scene->world;
+
+	const auto initial_hash = cosm.calculate_solvable_signi_hash<uint32_t>();
+	REQUIRE(initial_hash == cosm.calculate_solvable_signi_hash<uint32_t>());
+
+	{
+		bool altered = false;
+
+		/* Items were never covered by the old hash - make sure a divergence there is now detected. */
+		cosm.for_each_having<components::item>(
+			[&](const auto typed_item) {
+				if (!altered) {
+					typed_item.set_charges(typed_item.get_charges() + 1);
+					altered = true;
+				}
+			}
+		);
+
+		REQUIRE(altered);
+		REQUIRE(initial_hash != cosm.calculate_solvable_signi_hash<uint32_t>());
+	}
+
+	/* The hash as it was before: only the bodies and the meters of the sentient entities. */
+	auto calc_sentience_hash = [&]() {
+		thread_local augs::memory_stream ss;
+		ss.set_write_pos(0);
+
+		augs::write_bytes(ss, cosm.get_clock().now);
+		augs::write_bytes(ss, cosm.get_entities_count());
+
+		cosm.for_each_having<components::sentience>(
+			[&](const auto& it) {
+				augs::write_bytes(ss, it.template get<components::rigid_body>().get_raw_component());
+				augs::write_bytes(ss, it.template get<components::sentience>().meters);
+			}
+		);
+
+		return crc32buf(reinterpret_cast<char*>(ss.data()), ss.get_write_pos());
+	};
+
+	const auto num_passes = 1000;
+
+	auto measure = [&](auto&& pass) {
+		augs::timer t;
+
+		/* So that the passes are not optimized out. */
+		volatile uint32_t checksum = 0;
+
+		for (int i = 0; i < num_passes; ++i) {
+			checksum = checksum ^ pass();
+		}
+
+		return t.get<std::chrono::microseconds>() / num_passes;
+	};
+
+	const auto full_us = measure([&]() { return cosm.calculate_solvable_signi_hash<uint32_t>(); });
+	const auto sentience_us = measure(calc_sentience_hash);
+
+	/* The server hashes once every state_hash_once_every_tick steps, which is every step by default. */
+	const auto step_us = [&]() {
+		const auto entropy = cosmic_entropy();
+		const auto settings = solve_settings();
+
+		augs::timer t;
+
+		for (int i = 0; i < num_passes; ++i) {
+			standard_solver()(
+				logic_step_input { cosm, entropy, settings },
+				solver_callbacks()
+			);
+		}
+
+		return t.get<std::chrono::microseconds>() / num_passes;
+	}();
+
+	LOG(
+		"Entities: %x. Step: %x us. Full state hash: %x us (%x of a step). Sentience-only hash as before: %x us (%x of a step)",
+		cosm.get_entities_count(),
+		step_us,
+		full_us,
+		full_us / step_us,
+		sentience_us,
+		sentience_us / step_us
+	);
+}
+
+TEST_CASE("Benchmark NeonMapRegeneration", "[.benchmark]") {
+	const auto scene = make_testbed();
+
+	std::size_t num_maps = 0;
+
+	augs::timer t;
+
+	for (const auto& d : scene->viewables.image_definitions) {
+		if (d.meta.extra_loadables.should_generate_neon_map()) {
+			image_definition_view(augs::path_type(), d).regenerate_neon_map(true);
+			++num_maps;
+		}
+	}
+
+	LOG("neon_maps_regeneration of %x official images: %x ms", num_maps, t.get<std::chrono::milliseconds>());
+}
+
+TEST_CASE("Benchmark TestSceneStep", "[.benchmark]") {
+	const auto scene = make_testbed();
+	auto& cosm = scene->world;
+
+	const auto entropy = cosmic_entropy();
+	const auto settings = solve_settings();
+
+	const auto num_steps = 1000;
+
+	augs::timer t;
+
+	for (int i = 0; i < num_steps; ++i) {
+		standard_solver()(
+			logic_step_input { cosm, entropy, settings },
+			solver_callbacks()
+		);
+	}
+
+	LOG("Test scene step with %x entities: %x us", cosm.get_entities_count(), t.get<std::chrono::microseconds>() / num_steps);
+}
+
+TEST_CASE("Benchmark ParallelSolveStages", "[.benchmark]") {
+	const auto entropy = cosmic_entropy();
+	const auto num_steps = 1000;
+
+	auto run = [&](const unsigned num_additional_workers) {
+		const auto scene = make_testbed();
+		auto& cosm = scene->world;
+
+		auto settings = solve_settings();
+		settings.num_additional_workers = num_additional_workers;
+
+		augs::timer t;
+
+		for (int i = 0; i < num_steps; ++i) {
+			standard_solver()(
+				logic_step_input { cosm, entropy, settings },
+				solver_callbacks()
+			);
+		}
+
+		const auto& p = cosm.profiler;
+
+		LOG(
+			"Additional workers: %x, step: %x us, stages: %x, %x%x",
+			num_additional_workers,
+			t.get<std::chrono::microseconds>() / num_steps,
+			p.solve_stages.size(),
+			p.solve_critical_path.summary(),
+			p.solve_work.summary()
+		);
+
+		for (const auto& stage : p.solve_stages) {
+			if (stage.title.find(" + ") != std::string::npos) {
+				LOG("Critical path of %x", stage.summary());
+			}
+		}
+
+		return cosm.calculate_solvable_signi_hash<uint32_t>();
+	};
+
+	const auto serial_hash = run(0);
+
+	/* The outcome must not depend on the number of workers. */
+	REQUIRE(serial_hash == run(1));
+	REQUIRE(serial_hash == run(3));
+}
+
+TEST_CASE("Benchmark PhysicsWorldCloning", "[.benchmark]") {
+	const auto scene = make_testbed();
+	auto& cosm = scene->world;
+
+	const auto entropy = cosmic_entropy();
+	const auto settings = solve_settings();
+
+	auto advance = [&](cosmos& advanced, const int num_steps) {
+		for (int i = 0; i < num_steps; ++i) {
+			standard_solver()(
+				logic_step_input { advanced, entropy, settings },
+				solver_callbacks()
+			);
+		}
+	};
+
+	/* So that there are contacts and sleeping bodies to clone. */
+	advance(cosm, 100);
+
+	{
+		const auto& physics = cosm.get_solvable_inferred().physics;
+		const auto& world = physics.get_b2world();
+
+		auto target = std::make_unique<physics_world_cache>();
+
+		const auto num_passes = 100;
+
+		augs::timer t;
+
+		for (int i = 0; i < num_passes; ++i) {
+			*target = physics;
+		}
+
+		LOG(
+			"Physics world clone with %x bodies, %x contacts: %x us",
+			world.GetBodyCount(),
+			world.GetContactCount(),
+			t.get<std::chrono::microseconds>() / num_passes
+		);
+
+		REQUIRE(target->get_b2world().GetBodyCount() == world.GetBodyCount());
+		REQUIRE(target->get_b2world().GetContactCount() == world.GetContactCount());
+	}
+
+	/* The clone must step exactly like the original. */
+
+	auto cloned = std::make_unique<cosmos>();
+	*cloned = cosm;
+
+	advance(cosm, 300);
+	advance(*cloned, 300);
+
+	REQUIRE(cosm.calculate_solvable_signi_hash<uint32_t>() == cloned->calculate_solvable_signi_hash<uint32_t>());
+}
+
+TEST_CASE("Benchmark RepredictionClone", "[.benchmark]") {
+	const auto scene = make_testbed();
+	auto& referential = scene->world;
+
+	/* Plenty of entities that the steps never touch, like on a real map. */
+	for (int i = 0; i < 2000; ++i) {
+		const auto pos = vec2(100000.f, 100000.f) + vec2(static_cast<float>(i % 50), static_cast<float>(i / 50)) * 100.f;
+		create_test_scene_entity(referential, test_sprite_decorations::AQUARIUM_SAND_1, pos);
+	}
+
+	const auto entropy = cosmic_entropy();
+	const auto settings = solve_settings();
+
+	auto advance = [&](cosmos& advanced, const int num_steps) {
+		for (int i = 0; i < num_steps; ++i) {
+			standard_solver()(
+				logic_step_input { advanced, entropy, settings },
+				solver_callbacks()
+			);
+		}
+	};
+
+	advance(referential, 60);
+
+	/* All of these are too big for the stack. */
+	const auto predicted_ptr = std::make_unique<cosmos>();
+	const auto whole_copy = std::make_unique<cosmos_solvable>();
+
+	auto& predicted = *predicted_ptr;
+	predicted = referential;
+	predicted.assign_solvable(referential);
+
+	/* As many steps as the client predicts ahead of the server on a decent connection. */
+	const auto num_predicted_steps = 3;
+	const auto num_passes = 100;
+
+	double whole_us = 0.0;
+	double changed_us = 0.0;
+	std::size_t num_copied_pools = 0;
+
+	for (int i = 0; i < num_passes; ++i) {
+		advance(referential, 1);
+		advance(predicted, num_predicted_steps);
+
+		{
+			augs::timer t;
+			*whole_copy = referential.get_solvable();
+			whole_us += t.get<std::chrono::microseconds>();
+		}
+
+		{
+			augs::timer t;
+			num_copied_pools += predicted.assign_solvable(referential);
+			changed_us += t.get<std::chrono::microseconds>();
+		}
+
+		REQUIRE(predicted.calculate_solvable_signi_hash<uint32_t>() == referential.calculate_solvable_signi_hash<uint32_t>());
+	}
+
+	LOG(
+		"Reprediction clone of %x entities: whole %x us, changed pools only %x us (%x of %x pools copied on average)",
+		referential.get_entities_count(),
+		whole_us / num_passes,
+		changed_us / num_passes,
+		static_cast<double>(num_copied_pools) / num_passes,
+		num_types_in_list_v<all_entity_types>
+	);
+}
+
+TEST_CASE("Benchmark SweptMissiles", "[.benchmark]") {
+	const auto entropy = cosmic_entropy();
+	const auto settings = solve_settings();
+
+	const auto num_steps = 600;
+	const auto rounds_per_shooter = 2;
+
+	auto run = [&](const bool swept_rays) {
+		const auto scene = make_testbed();
+		auto& cosm = scene->world;
+
+		cosm.change_common_significant([&](cosmos_common_significant& common) {
+			common.missiles.swept_rays = swept_rays;
+			return changer_callback_result::REFRESH;
+		});
+
+		/* Every character keeps firing from where it stood, even after it dies. */
+		std::vector<std::pair<entity_id, transformr>> shooters;
+
+		cosm.for_each_having<components::sentience>(
+			[&](const auto sentient) {
+				shooters.emplace_back(sentient.get_id(), sentient.get_logic_transform());
+			}
+		);
+
+		REQUIRE(shooters.size() > 0);
+
+		auto rng = randomization(0);
+		std::size_t num_fired = 0;
+
+		augs::timer t;
+
+		for (int i = 0; i < num_steps; ++i) {
+			for (const auto& shooter_and_muzzle : shooters) {
+				const auto shooter_id = shooter_and_muzzle.first;
+				const auto muzzle = shooter_and_muzzle.second;
+
+				for (int r = 0; r < rounds_per_shooter; ++r) {
+					/* The same cap for both modes, so that they simulate as many missiles. */
+					if (cosm.get_solvable().get_count_of<plain_missile>() >= plain_missile::statically_allocated_entities) {
+						break;
+					}
+
+					const auto degrees = rng.randval(0.f, 360.f);
+					const auto speed = rng.randval(3000.f, 6000.f);
+
+					create_test_scene_entity(cosm, test_plain_missiles::CYAN_ROUND, [&](const auto round, auto&&...) {
+						round.set_logic_transform(transformr(muzzle.pos, degrees));
+						round.template get<components::rigid_body>().set_velocity(vec2::from_degrees(degrees) * speed);
+
+						if (const auto shooter = cosm[shooter_id]) {
+							round.template get<components::sender>().set(shooter);
+						}
+					});
+
+					++num_fired;
+				}
+			}
+
+			standard_solver()(
+				logic_step_input { cosm, entropy, settings },
+				solver_callbacks()
+			);
+		}
+
+		LOG(
+			"Swept rays: %x. Fired: %x, step: %x us, physics step: %x, missiles: %x",
+			swept_rays,
+			num_fired,
+			t.get<std::chrono::microseconds>() / num_steps,
+			cosm.profiler.physics_step.summary(),
+			cosm.profiler.missiles.summary()
+		);
+
+		return cosm.calculate_solvable_signi_hash<uint32_t>();
+	};
+
+	run(false);
+
+	/* The swept missiles must be just as deterministic as the bodies. */
+	REQUIRE(run(true) == run(true));
+}
+
+TEST_CASE("Benchmark FishFlocking", "[.benchmark]") {
+	const auto entropy = cosmic_entropy();
+	const auto settings = solve_settings();
+
+	const auto num_steps = 200;
+
+	auto run = [&](const std::size_t num_fish) {
+		const auto scene = make_testbed();
+		auto& cosm = scene->world;
+
+		std::optional<typed_entity_flavour_id<complex_decoration>> flavour;
+		entity_id origin_id;
+		std::size_t num_existing = 0;
+
+		cosm.for_each_having<components::movement_path>(
+			[&](const auto typed_fish) {
+				++num_existing;
+
+				if (flavour == std::nullopt && typed_fish.template get<invariants::movement_path>().fish_movement.is_enabled) {
+					flavour = typed_fish.get_flavour_id();
+					origin_id = typed_fish.template get<components::movement_path>().origin;
+				}
+			}
+		);
+
+		REQUIRE(flavour != std::nullopt);
+
+		if (statically_allocate_entities && num_existing + num_fish > complex_decoration::statically_allocated_entities) {
+			LOG("Fish: %x, skipped - exceeds the statically allocated pool.", num_fish);
+			return std::optional<uint32_t>();
+		}
+
+		/* Populate the aquarium of the first fish with its clones. */
+		const auto origin = cosm[origin_id];
+		const auto area = origin.get_logic_transform();
+		const auto h = origin.get_logical_size() / 2;
+
+		randomization rng = static_cast<rng_seed_type>(num_fish);
+
+		for (std::size_t i = 0; i < num_fish; ++i) {
+			const auto where = transformr(
+				area.pos + vec2(rng.randval(-h.x, h.x), rng.randval(-h.y, h.y)),
+				rng.randval(0.f, 360.f)
+			);
+
+			const auto fish = cosmic::specific_create_entity(
+				cosm,
+				*flavour,
+				[&](const auto handle, auto&&...) {
+					handle.set_logic_transform(where);
+				}
+			);
+
+			fish.get<components::movement_path>().origin = origin_id;
+		}
+
+		for (int i = 0; i < num_steps; ++i) {
+			standard_solver()(
+				logic_step_input { cosm, entropy, settings },
+				solver_callbacks()
+			);
+		}
+
+		LOG("Fish: %x, movement paths: %x us", num_fish, cosm.profiler.movement_paths.get_average_units() * 1000000);
+
+		return std::make_optional(cosm.calculate_solvable_signi_hash<uint32_t>());
+	};
+
+	REQUIRE(run(100) == run(100));
+
+	for (const std::size_t num_fish : { 500, 1000, 2500, 5000 }) {
+		run(num_fish);
+	}
+}
+
+TEST_CASE("Benchmark EntityIteration", "[.benchmark]") {
+	using E = plain_sprited_body;
+	using S = entity_solvable<E>;
+	using C = components::interpolation;
+
+	/*
+		The same component in both layouts, with the same entities around it,
+		so that only the memory layout differs.
+		Standalone containers are used because the pools of a cosmos might be statically allocated.
+	*/
+
+	struct entity_with_inline_component {
+		S solvable;
+		C component;
+	};
+
+	using column_pool_type = augs::column_pool<S, soa_components_of<E>, make_vector, unsigned>;
+
+	const auto num_passes = 100;
+
+	auto measure = [&](auto&& pass) {
+		augs::timer t;
+
+		/* So that the passes are not optimized out. */
+		volatile real32 checksum = 0.f;
+
+		for (int i = 0; i < num_passes; ++i) {
+			checksum = checksum + pass();
+		}
+
+		return t.get<std::chrono::microseconds>() / num_passes;
+	};
+
+	for (const std::size_t num_entities : { 1000, 10000, 50000 }) {
+		std::vector<entity_with_inline_component> inline_entities(num_entities);
+
+		const auto pool = std::make_unique<column_pool_type>();
+
+		for (std::size_t i = 0; i < num_entities; ++i) {
+			pool->allocate(raw_entity_flavour_id(), augs::stepped_timestamp());
+		}
+
+		auto& column = pool->get_column<C>();
+
+		REQUIRE(column.size() == num_entities);
+
+		for (std::size_t i = 0; i < num_entities; ++i) {
+			inline_entities[i].component.place_of_birth.pos.x = static_cast<real32>(i);
+			column[i].place_of_birth.pos.x = static_cast<real32>(i);
+		}
+
+		const auto inline_us = measure([&]() {
+			real32 sum = 0.f;
+
+			for (const auto& e : inline_entities) {
+				sum += e.component.place_of_birth.pos.x;
+			}
+
+			return sum;
+		});
+
+		const auto column_us = measure([&]() {
+			real32 sum = 0.f;
+
+			for (const auto& c : column) {
+				sum += c.place_of_birth.pos.x;
+			}
+
+			return sum;
+		});
+
+		LOG(
+			"Entities: %x (%x bytes each). Interpolation inside the entities: %x us, in a column: %x us",
+			num_entities,
+			sizeof(entity_with_inline_component),
+			inline_us,
+			column_us
+		);
+	}
+
+	/*
+		The same through the cosmos, on the test scene populated with extra entities of a single type.
+		Crates keep their interpolation in a column, defuse kits still keep it inside the entity,
+		so these two testbeds stand for the layouts after and before the columns.
+		The bare test scene is measured as well, as it is iterated by every pass.
+	*/
+
+	const auto num_populated = 1000;
+
+	auto measure_cosmos = [&](const std::string& name, auto populate) {
+		const auto scene = make_testbed();
+		auto& cosm = scene->world;
+
+		std::vector<entity_id> ids;
+		populate(cosm, ids);
+
+		cosm.for_each_component<C>(
+			[&](const auto& handle, C& interpolation) {
+				interpolation.place_of_birth.pos.x = static_cast<real32>(handle.get_id().raw.indirection_index);
+			}
+		);
+
+		const auto having_us = measure([&]() {
+			real32 sum = 0.f;
+
+			cosm.for_each_having<C>(
+				[&](const auto& handle) {
+					sum += handle.template get<C>().place_of_birth.pos.x;
+				}
+			);
+
+			return sum;
+		});
+
+		const auto component_us = measure([&]() {
+			real32 sum = 0.f;
+
+			cosm.for_each_component<C>(
+				[&](const auto&, const C& interpolation) {
+					sum += interpolation.place_of_birth.pos.x;
+				}
+			);
+
+			return sum;
+		});
+
+		const auto handle_us = measure([&]() {
+			real32 sum = 0.f;
+
+			for (const auto& id : ids) {
+				if (const auto interpolation = cosm[id].template find<C>()) {
+					sum += interpolation->place_of_birth.pos.x;
+				}
+			}
+
+			return sum;
+		});
+
+		LOG(
+			"%x: %x entities. for_each_having: %x us, for_each_component: %x us, handle access of %x entities: %x us",
+			name,
+			cosm.get_entities_count(),
+			having_us,
+			component_us,
+			ids.size(),
+			handle_us
+		);
+	};
+
+	auto populate_with = [&](const auto flavour) {
+		return [flavour](cosmos& cosm, std::vector<entity_id>& ids) {
+			for (int i = 0; i < num_populated; ++i) {
+				const auto where = transformr(vec2(static_cast<real32>(i % 40) * 100.f, 10000.f + static_cast<real32>(i / 40) * 100.f));
+				ids.push_back(create_test_scene_entity(cosm, flavour, where).get_id());
+			}
+		};
+	};
+
+	measure_cosmos("Test scene", [](cosmos& cosm, std::vector<entity_id>& ids) {
+		cosm.for_each_having<C>([&](const auto& handle) { ids.push_back(handle.get_id()); });
+	});
+
+	measure_cosmos("With crates (column)", populate_with(test_plain_sprited_bodies::CRATE));
+	measure_cosmos("With defuse kits (inside the entity)", populate_with(test_tool_items::DEFUSE_KIT));
+}
+
+TEST_CASE("Benchmark EntityPoolCloning", "[.benchmark]") {
+	using E = plain_sprited_body;
+	using S = entity_solvable<E>;
+
+	using static_pool = augs::column_pool<S, soa_components_of<E>, of_size<E::statically_allocated_entities>::template make_nontrivial_constant_vector, unsigned short>;
+	using paged_pool = augs::column_pool<S, soa_components_of<E>, of_page_size<entity_pool_page_size>::template make_paged_vector, unsigned>;
+
+	LOG("sizeof static pool: %x, sizeof paged pool: %x", sizeof(static_pool), sizeof(paged_pool));
+
+	for (const std::size_t num_entities : { 10, 100, 1000, 3000 }) {
+		LOG(
+			"Entities: %x. Static pool clone: %x us, paged pool clone: %x us",
+			num_entities,
+			measure_pool_cloning<static_pool>(num_entities),
+			measure_pool_cloning<paged_pool>(num_entities)
+		);
+	}
+
+	/* Beyond what unsigned short ids can address */
+	for (const std::size_t num_entities : { 10000, 100000 }) {
+		LOG("Entities: %x. Paged pool clone: %x us", num_entities, measure_pool_cloning<paged_pool>(num_entities));
+	}
+}
+
+TEST_CASE("Benchmark IntercosmFormat", "[.benchmark]") {
+	const auto target_folder = augs::path_type(GENERATED_FILES_DIR "/benchmarks/intercosm");
+	augs::create_directories(target_folder);
+
+	auto run = [&](const std::string& name, const intercosm& source) {
+		const auto paths = intercosm_paths(target_folder, name);
+		const auto num_passes = 10;
+
+		augs::timer t;
+
+		for (int i = 0; i < num_passes; ++i) {
+			augs::save_as_bytes(source.viewables, paths.viewables_file);
+			augs::save_as_bytes(source.world.get_common_significant(), paths.comm_file);
+			augs::save_as_bytes(source.world.get_solvable().significant, paths.solv_file);
+		}
+
+		const auto legacy_save_ms = t.extract<std::chrono::milliseconds>() / num_passes;
+
+		auto loaded = std::make_unique<intercosm>();
+		augs::remove_file(paths.binary_file);
+
+		for (int i = 0; i < num_passes; ++i) {
+			loaded->load_from_bytes(paths);
+		}
+
+		const auto legacy_load_ms = t.extract<std::chrono::milliseconds>() / num_passes;
+
+		for (int i = 0; i < num_passes; ++i) {
+			source.save_as_bytes(paths);
+		}
+
+		const auto binary_save_ms = t.extract<std::chrono::milliseconds>() / num_passes;
+
+		for (int i = 0; i < num_passes; ++i) {
+			loaded->load_from_bytes(paths);
+		}
+
+		const auto binary_load_ms = t.extract<std::chrono::milliseconds>() / num_passes;
+
+		const auto written = source.to_binary();
+
+		REQUIRE(written == augs::file_to_bytes(paths.binary_file));
+		REQUIRE(written == loaded->to_binary());
+		REQUIRE(source.world.calculate_solvable_signi_hash<uint32_t>() == loaded->world.calculate_solvable_signi_hash<uint32_t>());
+
+		LOG(
+			"Intercosm %x (%x bytes). Legacy save: %x ms, load: %x ms. Binary save: %x ms, load: %x ms.",
+			name,
+			written.size(),
+			legacy_save_ms,
+			legacy_load_ms,
+			binary_save_ms,
+			binary_load_ms
+		);
+	};
+
+	run("testbed", *make_testbed());
+
+	if (augs::exists(ARENAS_DIR)) {
+		for (const auto& entry : std::experimental::filesystem::directory_iterator(ARENAS_DIR)) {
+			if (!std::experimental::filesystem::is_directory(entry.path())) {
+				continue;
+			}
+
+			const auto name = entry.path().filename().string();
+			const auto arena = std::make_unique<intercosm>();
+
+			arena->load_from_bytes(arena_paths(name).int_paths);
+			run(name, *arena);
+		}
+	}
+}
+
+TEST_CASE("Benchmark ParticleIntegration", "[.benchmark]") {
+	const auto num_passes = 200;
+	const auto delta = augs::delta::steps_per_second(60);
+
+	auto make_particle = [](randomization& rng) {
+		general_particle p;
+
+		p.pos = vec2(rng.randval(-1000.f, 1000.f), rng.randval(-1000.f, 1000.f));
+		p.vel = vec2(rng.randval(-500.f, 500.f), rng.randval(-500.f, 500.f));
+		p.acc = vec2(rng.randval(-50.f, 50.f), rng.randval(-50.f, 50.f));
+		p.linear_damping = rng.randval(0.f, 100.f);
+		p.rotation_speed = rng.randval(-360.f, 360.f);
+		p.angular_damping = rng.randval(0.f, 50.f);
+
+		/* So that none of them dies during the benchmark. */
+		p.max_lifetime_ms = 1e9f;
+
+		return p;
+	};
+
+	const auto scene = make_testbed();
+	const auto interp = std::make_unique<interpolation_system>();
+	const auto& anims = scene->world.get_logical_assets().plain_animations;
+
+	/* One particle at a time, like it was done before the particles were stored in columns. */
+	const auto per_particle_us = [&]() {
+		auto rng = randomization(0);
+		per_particle_layer_t<std::vector<general_particle>> layers;
+
+		for (auto& layer : layers) {
+			for (std::size_t i = 0; i < general_particle::statically_allocate; ++i) {
+				layer.push_back(make_particle(rng));
+			}
+		}
+
+		augs::timer t;
+
+		for (int pass = 0; pass < num_passes; ++pass) {
+			for (auto& layer : layers) {
+				erase_if(layer, [](const auto& p) { return p.is_dead(); });
+
+				for (auto& p : layer) {
+					p.integrate(delta.in_seconds());
+				}
+			}
+		}
+
+		return t.get<std::chrono::microseconds>() / num_passes;
+	}();
+
+	LOG("Particles: %x. Per particle: %x us", general_particle::statically_allocate * std::size_t(particle_layer::COUNT), per_particle_us);
+
+	for (const unsigned num_additional_workers : { 0u, 1u, 3u }) {
+		auto rng = randomization(0);
+
+		/* Too big for the stack. */
+		const auto particles = std::make_unique<particles_simulation_system>();
+
+		for (std::size_t l = 0; l < std::size_t(particle_layer::COUNT); ++l) {
+			for (std::size_t i = 0; i < general_particle::statically_allocate; ++i) {
+				particles->add_particle(particle_layer(l), make_particle(rng));
+			}
+		}
+
+		augs::timer t;
+
+		for (int pass = 0; pass < num_passes; ++pass) {
+			particles->integrate_all_particles(scene->world, delta, anims, *interp, num_additional_workers);
+		}
+
+		LOG(
+			"Additional workers: %x. Columns: %x us",
+			num_additional_workers,
+			t.get<std::chrono::microseconds>() / num_passes
+		);
+
+		REQUIRE(particles->count_all_particles() == general_particle::statically_allocate * std::size_t(particle_layer::COUNT));
+	}
+}
+
+TEST_CASE("Benchmark StaticBatches", "[.benchmark]") {
+	const auto num_passes = 200;
+	const auto side = 100;
+	const auto spacing = 40.f;
+
+	const auto scene = make_testbed();
+	auto& cosm = scene->world;
+
+	for (int y = 0; y < side; ++y) {
+		for (int x = 0; x < side; ++x) {
+			const auto pos = vec2(x - side / 2, y - side / 2) * spacing;
+			create_test_scene_entity(cosm, test_sprite_decorations::AQUARIUM_SAND_1, pos);
+		}
+	}
+
+	/* All of these are too big for the stack. */
+	const auto manager = std::make_unique<images_in_atlas_map>();
+	const auto interp = std::make_unique<interpolation_system>();
+	const auto randomizing = std::make_unique<randomizing_system>();
+	const auto batches = std::make_unique<static_batch_system>();
+
+	const auto cone = camera_cone(camera_eye(vec2::zero, 1.f), vec2i(1920, 1080));
+
+	visible_entities visible;
+
+	visible.reacquire_all_and_sort({
+		cosm,
+		cone,
+		visible_entities_query::accuracy_type::PROXIMATE,
+		visible_entities_query::dont_filter(),
+		tree_of_npo_filter::all_drawables()
+	});
+
+	augs::vertex_triangle_buffer triangles;
+
+	const auto in = draw_renderable_input {
+		{ augs::drawer { triangles }, *manager, 0.0, flip_flags(), *randomizing, cone },
+		*interp
+	};
+
+	const auto num_visible_in_baked_layers = [&]() {
+		std::size_t n = 0;
+
+		visible.for_each<render_layer::ON_FLOOR>(cosm, [&](const auto) {
+			++n;
+		});
+
+		return n;
+	}();
+
+	/* How the baked layers were drawn before. */
+	const auto unbaked_us = [&]() {
+		augs::timer t;
+
+		for (int pass = 0; pass < num_passes; ++pass) {
+			triangles.clear();
+
+			visible.for_each<render_layer::ON_FLOOR>(cosm, [&](const auto handle) {
+				::draw_entity(handle, in);
+			});
+		}
+
+		return t.get<std::chrono::microseconds>() / num_passes;
+	}();
+
+	const auto num_unbaked_triangles = triangles.size();
+
+	/* The first update bakes all cells in view, so it is not measured. */
+	batches->update({ cosm, visible, in });
+
+	const auto baked_us = [&]() {
+		augs::timer t;
+
+		for (int pass = 0; pass < num_passes; ++pass) {
+			triangles.clear();
+
+			batches->update({ cosm, visible, in });
+			batches->draw(render_layer::ON_FLOOR, in.drawer);
+
+			visible.for_each<render_layer::ON_FLOOR>(cosm, [&](const auto handle) {
+				if (!batches->is_baked(handle.get_id())) {
+					::draw_entity(handle, in);
+				}
+			});
+		}
+
+		return t.get<std::chrono::microseconds>() / num_passes;
+	}();
+
+	REQUIRE(batches->last_update_stats.rebaked_cells == 0);
+
+	/* Whole cells are drawn, so they might reach outside of the view. */
+	REQUIRE(triangles.size() >= num_unbaked_triangles);
+
+	LOG(
+		"Decorations: %x, in view: %x. Unbaked: %x us, baked: %x us",
+		cosm.get_solvable().get_count_of<sprite_decoration>(),
+		num_visible_in_baked_layers,
+		unbaked_us,
+		baked_us
+	);
+}
+#endif
@@ -19,6 +19,11 @@ struct network_profiler : public augs::profiler_mixin<network_profiler> {
 	augs::amount_measurements<std::size_t> predicted_steps = 1;
 	augs::amount_measurements<std::size_t> accepted_commands = 1;
 
+	augs::amount_measurements<std::size_t> jitter_buffer_depth = 60;
+	augs::amount_measurements<std::size_t> jitter_buffer_target = 1;
+	augs::amount_measurements<std::size_t> jitter_buffer_underruns = 1;
+	augs::amount_measurements<double> arrival_jitter = 1;
+
 	augs::time_measurements unpacking_remote_steps;
 	augs::time_measurements stepping_forward;
 	augs::time_measurements sending_messages;
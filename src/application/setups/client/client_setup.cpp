@@ -181,6 +181,8 @@ message_handler_result client_setup::handle_server_message(
 				return abort_v;
 			}
 
+			arena_baseline = net_messages::make_initial_arena_baseline(initial_signi);
+
 			/* Prepare the predicted cosmos. */
 			predicted_cosmos = scene.world;
 		}
@@ -197,24 +199,42 @@ message_handler_result client_setup::handle_server_message(
 		now_resyncing = false;
 
 		uint32_t read_client_id;
+		bool baseline_mismatch = false;
+		bool read_successfully = false;
 
 		cosmic::change_solvable_significant(
 			scene.world, 
 			[&](cosmos_solvable_significant& signi) {
-				read_payload(
+				read_successfully = read_payload(
 					buffers,
 
 					initial_payload {
 						signi,
 						current_mode,
-						read_client_id
+						read_client_id,
+						arena_baseline,
+						baseline_mismatch
 					}
 				);
 
-				return changer_callback_result::REFRESH;
+				return read_successfully ? changer_callback_result::REFRESH : changer_callback_result::DONT_REFRESH;
 			}
 		);
 
+		if (baseline_mismatch) {
+			LOG("Our arena files differ from the server's. Requesting the whole initial state.");
+
+			pending_request = special_client_request::RESYNC_WHOLE_STATE;
+			now_resyncing = true;
+
+			return continue_v;
+		}
+
+		if (!read_successfully) {
+			log_malicious_server();
+			return abort_v;
+		}
+
 		client_player_id = static_cast<mode_player_id>(read_client_id);
 
 		LOG("Received initial state from the server at step: %x.", scene.world.get_timestamp().step);
@@ -242,6 +262,16 @@ message_handler_result client_setup::handle_server_message(
 #endif
 	else if constexpr (std::is_same_v<T, networked_server_step_entropy>) {
 		if (state != client_state_type::IN_GAME) {
+			if (now_resyncing) {
+				/*
+					We have asked for the whole initial state as we could not apply its delta.
+					The server keeps sending us its steps in the meantime,
+					but the state it resends will already have them applied.
+				*/
+
+				return continue_v;
+			}
+
 			LOG("The server has sent entropy too early (state: %x). Disconnecting.", state);
 
 			log_malicious_server();
@@ -323,21 +353,22 @@ void client_setup::send_pending_commands() {
 		uint32_t exchanged_client_id = 0xdeadbeef;
 
 		std::vector<std::byte> initial_buf;
+		preserialized_initial_arena_state preserialized;
 
 		for (int i = 0; i < times; ++i) {
 			net_messages::initial_arena_state ss;
 			ss.Release();
 
 			auto write_all = [&]() {
-				return ss.write_payload(
+				net_messages::preserialize(
 					buffers,
-
-					initial_arena_state_payload<true> {
-						scene.world.get_solvable().significant,
-						current_mode,
-						exchanged_client_id
-					}
+					preserialized,
+					scene.world.get_solvable().significant,
+					current_mode,
+					arena_baseline
 				);
+
+				return ss.write_payload(preserialized, exchanged_client_id);
 			};
 
 			auto written = write_all();
@@ -392,13 +423,17 @@ void client_setup::send_pending_commands() {
 					[&](cosmos_solvable_significant& signi) {
 						ss.AttachBlock(yojimbo::GetDefaultAllocator(), reinterpret_cast<uint8_t*>(initial_buf.data()), initial_buf.size());
 
+						bool baseline_mismatch = false;
+
 						ss.read_payload(
 							buffers,
 
 							initial_payload {
 								signi,
 								current_mode,
-								exchanged_client_id
+								exchanged_client_id,
+								arena_baseline,
+								baseline_mismatch
 							}
 						);
 
@@ -433,8 +468,8 @@ void client_setup::send_pending_commands() {
 		}
 	}
 
-	if (pending_request == special_client_request::RESYNC) {
-		LOG("Sending the request resync command.");
+	if (pending_request != special_client_request::NONE) {
+		LOG("Sending the request resync command (%x).", static_cast<int>(pending_request));
 
 		client->send_payload(
 			game_channel_type::CLIENT_COMMANDS,
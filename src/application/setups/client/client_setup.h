@@ -57,6 +57,7 @@ class client_setup :
 	/* This is loaded from the arena folder */
 	intercosm scene;
 	cosmos_solvable_significant initial_signi;
+	initial_arena_baseline arena_baseline;
 
 	predefined_rulesets rulesets;
 
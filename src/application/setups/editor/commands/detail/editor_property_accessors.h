@@ -128,7 +128,7 @@ struct editor_property_accessors {
 							auto specific_handle = cosm[typed_entity_id<E>(e)];
 
 							const auto result = on_field_address(
-								std::get<Component>(specific_handle.get({}).components),
+								specific_handle.template get_component<Component>({}),
 								self.field,
 								[&](auto& resolved_field) -> callback_result {
 									return callback(resolved_field);
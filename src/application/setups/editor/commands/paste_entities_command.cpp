@@ -17,10 +17,10 @@ void paste_entities_command::push_entry(const const_entity_handle handle) {
 		using E = entity_type_of<decltype(typed_handle)>;
 		using vector_type = make_data_vector<E>;
 
-		auto solvable = typed_handle.get();
-		cosmic::make_suitable_for_cloning(solvable);
+		auto content = typed_handle.get_content();
+		cosmic::make_suitable_for_cloning(content);
 
-		pasted_entities.get<vector_type>().push_back({ solvable, handle.get_id() });
+		pasted_entities.get<vector_type>().push_back({ content, handle.get_id() });
 	});
 }
 
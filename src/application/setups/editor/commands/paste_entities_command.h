@@ -22,7 +22,7 @@ struct paste_entities_command {
 
 	template <class E>
 	struct pasted_entry {
-		entity_solvable<E> content;
+		entity_content<E> content;
 		entity_id id;
 	};
 
@@ -95,13 +95,8 @@ void editor_player_gui::perform(const editor_command_input cmd_in) {
 
 		const auto& snapshots = player.get_snapshots();
 
-		std::size_t total_snapshot_bytes = 0;
-
-		for (const auto& s : snapshots) {
-			total_snapshot_bytes += s.second.size();
-		}
-
-		text("Snapshots: %x (%x)", snapshots.size(), readable_bytesize(total_snapshot_bytes));
+		text("Snapshots: %x (%x)", snapshots.size(), readable_bytesize(player.get_snapshots_memory()));
+		text("Last seek: %x ms", player.get_last_seek_secs() * 1000);
 
 		if (snapshots.size() > 0) {
 			auto it = snapshots.upper_bound(player.get_current_step());
@@ -139,6 +139,25 @@ void editor_summary_gui::perform(editor_setup& setup) {
 		1.0f / cosm.get_fixed_delta().in_seconds()
 	);
 
+	{
+		const auto& player = f.player;
+		const auto& snapshots = player.get_snapshots();
+
+		const auto num_keyframes = std::count_if(
+			snapshots.begin(),
+			snapshots.end(),
+			[](const auto& s) { return s.second.keyframe; }
+		);
+
+		text("Player snapshots: %x (%x keyframes), memory: %x",
+			snapshots.size(),
+			num_keyframes,
+			readable_bytesize(player.get_snapshots_memory())
+		);
+
+		text("Last seek: %x ms", player.get_last_seek_secs() * 1000);
+	}
+
 	const auto viewed = setup.get_viewed_character();
 
 	text("Currently controlling: %x",
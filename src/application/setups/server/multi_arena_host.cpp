@@ -0,0 +1,109 @@
+#include "application/setups/server/multi_arena_host.h"
+#include "application/setups/server/server_setup.h"
+#include "application/network/network_adapters.h"
+#include "augs/templates/container_templates.h"
+#include "game/cosmos/solvers/solver_callbacks.h"
+
+static auto calc_num_arena_workers(const augs::dedicated_server_input& dedicated) {
+	const auto num_threads = dedicated.num_arena_threads > 0 
+		? dedicated.num_arena_threads 
+		: std::max(1u, std::thread::hardware_concurrency())
+	;
+
+	/* The calling thread also processes arenas while waiting for the workers. */
+	return static_cast<std::size_t>(num_threads - 1);
+}
+
+void multi_arena_host::arena_tick_worker::operator()(hosted_arena*& arena) const {
+	const auto zoom = 1.f;
+
+	arena->setup->advance(
+		{
+			vec2i(),
+			*settings,
+			zoom,
+			arena->network_performance,
+			arena->server_stats
+		},
+		solver_callbacks()
+	);
+}
+
+multi_arena_host::multi_arena_host(
+	sol::state& lua,
+	const server_start_input& first_arena_start,
+	const server_vars& initial_vars,
+	const augs::dedicated_server_input& dedicated
+) :
+	/* 1 ms resolution over a revolution of one second is plenty for tickrates up to 1 kHz. */
+	deadlines(0.001, 1000),
+	workers(calc_num_arena_workers(dedicated))
+{
+	const auto num_arenas = std::max(1u, dedicated.num_arenas);
+
+	arenas.reserve(num_arenas);
+	due_arenas.reserve(num_arenas);
+
+	for (unsigned i = 0; i < num_arenas; ++i) {
+		auto start = first_arena_start;
+		start.port = static_cast<unsigned short>(first_arena_start.port + i);
+
+		LOG("Starting arena %x of %x at port: %x", i + 1, num_arenas, start.port);
+
+		hosted_arena new_arena;
+
+		new_arena.setup = std::make_unique<server_setup>(
+			lua,
+			start,
+			initial_vars,
+			dedicated
+		);
+
+		arenas.emplace_back(std::move(new_arena));
+		schedule_next_tick_of(arenas.size() - 1);
+	}
+}
+
+multi_arena_host::~multi_arena_host() = default;
+
+void multi_arena_host::schedule_next_tick_of(const std::size_t index) {
+	deadlines.schedule(index, arenas[index].setup->get_next_tick_time());
+}
+
+void multi_arena_host::advance(const input_settings& settings) {
+	due_arenas.clear();
+
+	deadlines.advance(
+		yojimbo_time(),
+		[&](const std::size_t index) {
+			if (arenas[index].setup->is_running()) {
+				due_arenas.push_back(std::addressof(arenas[index]));
+			}
+		}
+	);
+
+	if (due_arenas.empty()) {
+		yojimbo_sleep(deadlines.get_resolution());
+		return;
+	}
+
+	workers.process(arena_tick_worker { std::addressof(settings) }, due_arenas);
+
+	for (const auto arena : due_arenas) {
+		schedule_next_tick_of(index_in(arenas, *arena));
+	}
+}
+
+bool multi_arena_host::is_running() const {
+	for (const auto& a : arenas) {
+		if (a.setup->is_running()) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+std::size_t multi_arena_host::get_num_arenas() const {
+	return arenas.size();
+}
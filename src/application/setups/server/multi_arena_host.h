@@ -0,0 +1,69 @@
+#pragma once
+#include <memory>
+#include <vector>
+
+#include "augs/misc/timing/timer_wheel.h"
+#include "augs/templates/range_workers.h"
+#include "augs/network/network_types.h"
+#include "application/session_profiler.h"
+#include "application/setups/server/server_start_input.h"
+
+class server_setup;
+struct server_vars;
+struct input_settings;
+
+namespace sol {
+	class state;
+}
+
+/*
+	Hosts several independent arenas in a single dedicated server process.
+	Each arena is a separate server_setup listening on its own port,
+	advanced on a pool of worker threads whenever its next tick is due.
+
+	All arenas are constructed on the calling thread,
+	so they can share a single lua state which is only used for loading.
+
+	Each arena still keeps its own copy of cosmos_common_significant, even if all load the same map.
+	The cosmos owns its common state by value and the editor mutates it in place,
+	so sharing it read-only would first need the cosmos to hold an immutable shared handle.
+*/
+
+class multi_arena_host {
+	struct hosted_arena {
+		std::unique_ptr<server_setup> setup;
+
+		network_profiler network_performance;
+		server_network_info server_stats;
+	};
+
+	struct arena_tick_worker {
+		const input_settings* settings = nullptr;
+
+		void operator()(hosted_arena*& arena) const;
+	};
+
+	std::vector<hosted_arena> arenas;
+	std::vector<hosted_arena*> due_arenas;
+
+	augs::timer_wheel<std::size_t> deadlines;
+	augs::range_workers<arena_tick_worker> workers;
+
+	void schedule_next_tick_of(std::size_t index);
+
+public:
+	multi_arena_host(
+		sol::state& lua,
+		const server_start_input& first_arena_start,
+		const server_vars& initial_vars,
+		const augs::dedicated_server_input& dedicated
+	);
+
+	~multi_arena_host();
+
+	/* Advances all arenas whose ticks are due. Sleeps briefly if none are. */
+	void advance(const input_settings&);
+
+	bool is_running() const;
+	std::size_t get_num_arenas() const;
+};
@@ -7,7 +7,7 @@
 #include "application/network/requested_client_settings.h"
 #include "application/network/client_state_type.h"
 
-using client_pending_entropies = std::vector<total_client_entropy>;
+using client_pending_entropies = augs::jitter_buffer<total_client_entropy>;
 
 struct server_client_state {
 	using type = client_state_type;
@@ -22,6 +22,8 @@ struct server_client_state {
 	unsigned resyncs_counter = 0;
 	net_time_t last_resync_counter_reset_at = 0;
 
+	bool needs_whole_initial_state = false;
+
 	server_client_state() = default;
 
 	server_client_state(const net_time_t server_time) {
@@ -53,6 +55,7 @@ struct server_client_state {
 		settings = {};
 		pending_entropies.clear();
 		num_entropies_accepted = 0;
+		needs_whole_initial_state = false;
 	}
 
 	void unset() {
@@ -20,6 +20,7 @@
 
 #include "application/arena/arena_handle.h"
 #include "application/arena/choose_arena.h"
+#include "application/session_profiler.h"
 
 /* To avoid incomplete type error */
 server_setup::~server_setup() {
@@ -137,6 +138,8 @@ void server_setup::choose_arena(const std::string& name) {
 	LOG("Choosing arena: %x", name);
 
 	vars.current_arena = name;
+	initial_state_snapshot_step = std::nullopt;
+	whole_initial_state_snapshot_step = std::nullopt;
 
 	::choose_arena(
 		lua,
@@ -145,6 +148,8 @@ void server_setup::choose_arena(const std::string& name) {
 		initial_signi
 	);
 
+	arena_baseline = net_messages::make_initial_arena_baseline(initial_signi);
+
 	if (should_have_admin_character()) {
 		mode_entropy_general cmd;
 
@@ -249,27 +254,25 @@ void server_setup::advance_clients_state() {
 		}
 
 		auto contribute_to_step_entropy = [&]() {
-#if 0
-			c.pending_entropies.set_lower_limit(
-				c.settings.net.requested_jitter_buffer_ms * inv_simulation_delta_ms;
-			);
-#endif
-
 			const auto jitter_vars = c.settings.net.jitter;
 			const auto jitter_squash_steps = in_steps(jitter_vars.merge_commands_when_above_ms);
 
 			auto& inputs = c.pending_entropies;
 
-			if (const auto num_pending = inputs.size(); num_pending > 0) {
-				const bool should_squash = num_pending >= jitter_squash_steps;
+			/* The requested buffer is the most latency the client agrees to pay for smoothing out its jitter. */
+			inputs.set_upper_limit(static_cast<std::size_t>(in_steps(jitter_vars.buffer_ms)));
+
+			if (const auto num_unpacked = inputs.next_step(); num_unpacked > 0) {
+				const auto num_pending = inputs.size();
+				const bool should_squash = num_pending >= jitter_squash_steps && num_pending > inputs.get_target_depth();
 
 				total_client_entropy entropy;
 
 				c.num_entropies_accepted = [&]() {
-					if (should_squash) {
+					if (should_squash || num_unpacked > 1) {
 						const auto num_squashed = static_cast<uint8_t>(
 							std::min(
-								num_pending,
+								should_squash ? num_pending : num_unpacked,
 								static_cast<std::size_t>(c.settings.net.jitter.max_commands_to_squash_at_once)
 							)
 						);
@@ -278,18 +281,13 @@ void server_setup::advance_clients_state() {
 							entropy += inputs[i];
 						}
 
-						if (num_squashed == num_pending) {
-							inputs.clear();
-						}
-						else {
-							erase_first_n(inputs, num_squashed);
-						}
+						inputs.pop_front(num_squashed);
 
 						return static_cast<uint8_t>(num_squashed);
 					}
 
-					entropy = inputs[0];
-					erase_first_n(inputs, 1);
+					entropy = inputs.front();
+					inputs.pop_front();
 
 					return static_cast<uint8_t>(1);
 				}();
@@ -354,13 +352,8 @@ void server_setup::advance_clients_state() {
 				client_id, 
 				game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
 
-				buffers,
-
-				initial_arena_state_payload<true> {
-					scene.world.get_solvable().significant,
-					current_mode,
-					sent_client_id
-				}
+				get_initial_state_snapshot_for(c),
+				sent_client_id
 			);
 
 			LOG("Sending initial payload for %x at step: %x", client_id, scene.world.get_total_steps_passed());
@@ -458,53 +451,121 @@ message_handler_result server_setup::handle_client_message(
 			return abort_v;
 		}
 
-		c.pending_entropies.emplace_back(std::move(payload));
+		c.pending_entropies.acquire_new_command(std::move(payload), static_cast<double>(current_simulation_step));
 		//LOG("Received %x th command from client. ", c.pending_entropies.size());
 	}
 	else if constexpr (std::is_same_v<T, special_client_request>) {
-		switch (payload) {
-			case special_client_request::RESYNC:
-				if (server_time >= c.last_resync_counter_reset_at + vars.reset_resync_timer_once_every_secs) {
-					c.resyncs_counter = 0;
-					c.last_resync_counter_reset_at = server_time;
-					LOG("Resetting the resync counter.");
-				}
+		if (!accept_initial_state_request(payload, c, vars, server_time, reinference_necessary)) {
+			return abort_v;
+		}
 
-				++c.resyncs_counter;
+		server->send_payload(
+			client_id, 
+			game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
 
-				LOG("Client has asked for a resync no %x.", c.resyncs_counter);
+			get_initial_state_snapshot_for(c),
+			static_cast<uint32_t>(client_id)
+		);
+	}
+	else {
+		static_assert(always_false_v<T>, "Unhandled payload type.");
+	}
 
-				if (c.resyncs_counter > vars.max_client_resyncs) {
-					LOG("Client is asking for a resync too often! Kicking.");
-					return abort_v;
-				}
+	c.last_valid_activity_time = server_time;
+	return message_handler_result::CONTINUE;
+}
 
-				server->send_payload(
-					client_id, 
-					game_channel_type::SERVER_SOLVABLE_AND_STEPS, 
+bool server_setup::accept_initial_state_request(
+	const special_client_request request,
+	server_client_state& c,
+	const server_vars& vars,
+	const net_time_t server_time,
+	bool& reinference_necessary
+) {
+	switch (request) {
+		case special_client_request::RESYNC_WHOLE_STATE:
+			/* 
+				Not a desync, but a one-time request of a joining client that could not apply the delta.
+				It is not counted against max_client_resyncs.
+			*/
 
-					buffers,
+			if (c.needs_whole_initial_state) {
+				LOG("Client has asked for the whole initial state again. Disconnecting.");
+				return false;
+			}
 
-					initial_arena_state_payload<true> {
-						scene.world.get_solvable().significant,
-						current_mode,
-						client_id
-					}
-				);
+			LOG("Client's arena differs from ours. It will be sent the whole initial state from now on.");
+			c.needs_whole_initial_state = true;
 
-				reinference_necessary = true;
+			break;
 
-				break;
+		case special_client_request::RESYNC:
+			if (server_time >= c.last_resync_counter_reset_at + vars.reset_resync_timer_once_every_secs) {
+				c.resyncs_counter = 0;
+				c.last_resync_counter_reset_at = server_time;
+				LOG("Resetting the resync counter.");
+			}
 
-			default: return abort_v;
-		}
+			++c.resyncs_counter;
+
+			LOG("Client has asked for a resync no %x.", c.resyncs_counter);
+
+			if (c.resyncs_counter > vars.max_client_resyncs) {
+				LOG("Client is asking for a resync too often! Kicking.");
+				return false;
+			}
+
+			break;
+
+		default: return false;
 	}
-	else {
-		static_assert(always_false_v<T>, "Unhandled payload type.");
+
+	/*
+		The client reinfers the state it receives from scratch,
+		so everyone else has to reinfer as well to stay in sync.
+	*/
+
+	reinference_necessary = true;
+	return true;
+}
+
+networked_server_step_entropy server_setup::make_networked_step_entropy(
+	const compact_server_step_entropy& total_input,
+	const bool reinference_necessary
+) {
+	networked_server_step_entropy total;
+	total.payload = total_input;
+	total.meta.reinference_required = reinference_necessary;
+
+	return total;
+}
+
+preserialized_initial_arena_state& server_setup::get_initial_state_snapshot(const bool against_baseline) {
+	/* 
+		The state does not change until the next step is simulated,
+		so every client that joins or resyncs during the same step gets the very same bytes.
+	*/
+
+	auto& snapshot = against_baseline ? initial_state_snapshot : whole_initial_state_snapshot;
+	auto& snapshot_step = against_baseline ? initial_state_snapshot_step : whole_initial_state_snapshot_step;
+
+	if (snapshot_step != current_simulation_step) {
+		net_messages::preserialize(
+			buffers,
+			snapshot,
+			scene.world.get_solvable().significant,
+			current_mode,
+			against_baseline ? arena_baseline : initial_arena_baseline()
+		);
+
+		snapshot_step = current_simulation_step;
 	}
 
-	c.last_valid_activity_time = server_time;
-	return message_handler_result::CONTINUE;
+	return snapshot;
+}
+
+preserialized_initial_arena_state& server_setup::get_initial_state_snapshot_for(const server_client_state& c) {
+	return get_initial_state_snapshot(!c.needs_whole_initial_state);
 }
 
 void server_setup::handle_client_messages() {
@@ -513,9 +574,7 @@ void server_setup::handle_client_messages() {
 }
 
 void server_setup::send_server_step_entropies(const compact_server_step_entropy& total_input) {
-	networked_server_step_entropy total;
-	total.payload = total_input;
-	total.meta.reinference_required = reinference_necessary;
+	auto total = make_networked_step_entropy(total_input, reinference_necessary);
 	total.meta.state_hash = [&]() -> decltype(total.meta.state_hash) {
 		auto& ticks_remaining = ticks_until_sending_hash;
 
@@ -523,13 +582,25 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 			ticks_remaining = vars.state_hash_once_every_tick;
 			--ticks_remaining;
 
-			const auto calculated_hash = get_arena_handle().get_cosmos().calculate_solvable_signi_hash<uint32_t>();
+			const auto calculated_hash = get_arena_handle().calculate_state_hash();
 			return calculated_hash;
 		}
 
 		return std::nullopt;
 	}();
 
+	/* 
+		Everything but the per-client context is identical for all clients,
+		so we serialize it only once per step and then reuse the same bytes.
+	*/
+
+	preserialized_server_step_entropy preserialized;
+
+	if (!net_messages::preserialize(preserialized, total)) {
+		LOG("Failed to serialize the server step entropy. It will not be sent.");
+		return;
+	}
+
 	for (auto& c : clients) {
 		if (!c.is_set()) {
 			continue;
@@ -545,32 +616,26 @@ void server_setup::send_server_step_entropies(const compact_server_step_entropy&
 
 		const auto client_id = static_cast<client_id_type>(index_in(clients, c));
 
-		{
-			{
-				prestep_client_context context;
-				context.num_entropies_accepted = c.num_entropies_accepted;
+		prestep_client_context context;
+		context.num_entropies_accepted = c.num_entropies_accepted;
+
+		c.num_entropies_accepted = 0;
 
 #if CONTEXTS_SEPARATE
-				server->send_payload(
-					client_id, 
-					game_channel_type::SERVER_SOLVABLE_AND_STEPS,
+		server->send_payload(
+			client_id, 
+			game_channel_type::SERVER_SOLVABLE_AND_STEPS,
 
-					context
-				);
-#else
-				total.context = context;
+			context
+		);
 #endif
-			}
 
-			c.num_entropies_accepted = 0;
-		}
-
-		/* TODO PERFORMANCE: only serialize the message once and multicast the same buffer to all clients! */
 		server->send_payload(
 			client_id,
 			game_channel_type::SERVER_SOLVABLE_AND_STEPS,
 
-			total
+			context,
+			preserialized
 		);
 	}
 }
@@ -665,6 +730,31 @@ void server_setup::update_stats(server_network_info& info) const {
 	info = server->get_server_network_info();
 }
 
+void server_setup::update_stats(network_profiler& performance) const {
+	std::size_t max_depth = 0;
+	std::size_t max_target = 0;
+	std::size_t total_underruns = 0;
+	double max_jitter = 0.0;
+
+	for (const auto& c : clients) {
+		if (c.state != client_state_type::IN_GAME) {
+			continue;
+		}
+
+		const auto& inputs = c.pending_entropies;
+
+		max_depth = std::max(max_depth, inputs.size());
+		max_target = std::max(max_target, inputs.get_target_depth());
+		total_underruns += inputs.get_underruns();
+		max_jitter = std::max(max_jitter, inputs.get_arrival_jitter());
+	}
+
+	performance.jitter_buffer_depth.measure(max_depth);
+	performance.jitter_buffer_target.measure(max_target);
+	performance.jitter_buffer_underruns.measure(total_underruns);
+	performance.arrival_jitter.measure(max_jitter);
+}
+
 server_step_entropy server_setup::unpack(const compact_server_step_entropy& n) const {
 	return n.unpack(
 		[&](const mode_player_id& mode_id) {
@@ -695,6 +785,8 @@ augs::path_type server_setup::get_unofficial_content_dir() const {
 #include "augs/misc/lua/lua_utils.h"
 #include <sol2/sol.hpp>
 #include "augs/readwrite/lua_file.h"
+#include "augs/readwrite/to_bytes.h"
+#include "augs/misc/timing/timer.h"
 
 TEST_CASE("NetSerialization EmptyEntropies") {
 	{
@@ -858,6 +950,231 @@ TEST_CASE("NetSerialization ServerEntropySecond") {
 	REQUIRE(received == sent);
 }
 
+static networked_server_step_entropy make_full_server_step_entropy(const std::size_t num_players) {
+	networked_server_step_entropy sent;
+	sent.meta.state_hash = 0xdeadbeef;
+
+	auto id = mode_player_id::first();
+
+	for (std::size_t i = 0; i < num_players; ++i) {
+		total_mode_player_entropy t;
+		t.cosmic.motions[game_motion_type::MOVE_CROSSHAIR] = { 34.f + i, 111.f - i };
+		t.cosmic.intents.push_back({ game_intent_type::MOVE_FORWARD, intent_change::PRESSED });
+		t.cosmic.intents.push_back({ game_intent_type::USE_BUTTON, intent_change::RELEASED });
+
+		sent.payload.players.push_back({ id, t });
+		id.value++;
+	}
+
+	return sent;
+}
+
+TEST_CASE("NetSerialization PreserializedServerEntropy") {
+	auto sent = make_full_server_step_entropy(10);
+	sent.context.num_entropies_accepted = 7;
+
+	net_messages::server_step_entropy whole;
+	whole.Release();
+	REQUIRE(whole.write_payload(sent));
+
+	preserialized_server_step_entropy preserialized;
+	REQUIRE(net_messages::preserialize(preserialized, sent));
+
+	net_messages::server_step_entropy patched;
+	patched.Release();
+	REQUIRE(patched.write_payload(sent.context, preserialized));
+
+	REQUIRE(whole.bytes == patched.bytes);
+
+	networked_server_step_entropy received;
+	REQUIRE(patched.read_payload(received));
+	REQUIRE(received == sent);
+}
+
+TEST_CASE("NetSerialization InitialStateBaselineMismatch") {
+	augs::serialization_buffers buffers;
+
+	auto make_arena = [](const std::string& name_suffix) {
+		cosmos_solvable_significant signi;
+
+		for (unsigned i = 0; i < 200; ++i) {
+			entity_id id;
+			id.raw.indirection_index = i;
+
+			signi.specific_names[id] = "Decoration number " + std::to_string(i) + name_suffix;
+		}
+
+		return signi;
+	};
+
+	const auto server_arena = make_arena("");
+	const auto server_baseline = net_messages::make_initial_arena_baseline(server_arena);
+	const auto different_baseline = net_messages::make_initial_arena_baseline(make_arena(" (modded)"));
+
+	REQUIRE(server_baseline.hash != different_baseline.hash);
+
+	auto server_state = server_arena;
+	server_state.clk.now.step = 1234;
+
+	online_mode_and_rules mode;
+	const auto sent_client_id = uint32_t(7);
+
+	auto send = [&](const initial_arena_baseline& against) {
+		preserialized_initial_arena_state preserialized;
+		net_messages::preserialize(buffers, preserialized, server_state, mode, against);
+
+		net_messages::initial_arena_state ss;
+		ss.Release();
+
+		return *ss.write_payload(preserialized, sent_client_id);
+	};
+
+	struct received_state {
+		bool read_successfully = false;
+		bool baseline_mismatch = false;
+		cosmos_solvable_significant signi;
+	};
+
+	auto receive = [&](std::vector<std::byte> block, const initial_arena_baseline& ours) {
+		received_state result;
+
+		online_mode_and_rules read_mode;
+		uint32_t read_client_id = 0;
+
+		net_messages::initial_arena_state ss;
+		ss.Release();
+		ss.AttachBlock(yojimbo::GetDefaultAllocator(), reinterpret_cast<uint8_t*>(block.data()), static_cast<int>(block.size()));
+
+		result.read_successfully = ss.read_payload(
+			buffers,
+
+			initial_arena_state_payload<false> {
+				result.signi,
+				read_mode,
+				read_client_id,
+				ours,
+				result.baseline_mismatch
+			}
+		);
+
+		ss.DetachBlock();
+
+		if (result.read_successfully) {
+			REQUIRE(read_client_id == sent_client_id);
+		}
+
+		return result;
+	};
+
+	const auto delta = send(server_baseline);
+	const auto whole = send(initial_arena_baseline());
+
+	REQUIRE(delta.size() < whole.size());
+
+	{
+		const auto matching = receive(delta, server_baseline);
+
+		REQUIRE(matching.read_successfully);
+		REQUIRE(!matching.baseline_mismatch);
+		REQUIRE(augs::to_bytes(matching.signi) == augs::to_bytes(server_state));
+	}
+
+	{
+		/* A client with different arena files asks for the whole state (RESYNC_WHOLE_STATE)... */
+		const auto mismatched = receive(delta, different_baseline);
+
+		REQUIRE(!mismatched.read_successfully);
+		REQUIRE(mismatched.baseline_mismatch);
+
+		/* ...which it can read regardless of its own baseline. */
+		const auto resent = receive(whole, different_baseline);
+
+		REQUIRE(resent.read_successfully);
+		REQUIRE(!resent.baseline_mismatch);
+		REQUIRE(augs::to_bytes(resent.signi) == augs::to_bytes(server_state));
+	}
+}
+
+TEST_CASE("NetSerialization WholeStateResendRequiresReinference") {
+	const auto vars = server_vars();
+
+	server_client_state c;
+	bool reinference_necessary = false;
+
+	REQUIRE(server_setup::accept_initial_state_request(special_client_request::RESYNC_WHOLE_STATE, c, vars, 0.0, reinference_necessary));
+
+	REQUIRE(c.needs_whole_initial_state);
+	REQUIRE(c.resyncs_counter == 0);
+	REQUIRE(reinference_necessary);
+
+	{
+		/* The step broadcast to all clients right after the resend. */
+		const auto broadcast = server_setup::make_networked_step_entropy(compact_server_step_entropy(), reinference_necessary);
+
+		preserialized_server_step_entropy preserialized;
+		REQUIRE(net_messages::preserialize(preserialized, broadcast));
+
+		net_messages::server_step_entropy sent;
+		sent.Release();
+		REQUIRE(sent.write_payload(prestep_client_context(), preserialized));
+
+		networked_server_step_entropy received;
+		REQUIRE(sent.read_payload(received));
+		REQUIRE(received.meta.reinference_required);
+	}
+
+	/* The whole state is sent only once per client. */
+	reinference_necessary = false;
+
+	REQUIRE(!server_setup::accept_initial_state_request(special_client_request::RESYNC_WHOLE_STATE, c, vars, 0.0, reinference_necessary));
+	REQUIRE(!reinference_necessary);
+
+	/* A regular resync requires reinference too. */
+	REQUIRE(server_setup::accept_initial_state_request(special_client_request::RESYNC, c, vars, 0.0, reinference_necessary));
+	REQUIRE(c.resyncs_counter == 1);
+	REQUIRE(reinference_necessary);
+}
+
+TEST_CASE("NetSerialization BroadcastBenchmark", "[.benchmark]") {
+	const auto num_ticks = 10000;
+	const auto num_clients = std::size_t(10);
+
+	auto sent = make_full_server_step_entropy(num_clients);
+
+	net_messages::server_step_entropy ss;
+	ss.Release();
+
+	augs::timer t;
+
+	for (int tick = 0; tick < num_ticks; ++tick) {
+		for (std::size_t c = 0; c < num_clients; ++c) {
+			sent.context.num_entropies_accepted = static_cast<uint8_t>(c);
+			ss.write_payload(sent);
+		}
+	}
+
+	const auto per_client_ms = t.extract<std::chrono::milliseconds>();
+
+	for (int tick = 0; tick < num_ticks; ++tick) {
+		preserialized_server_step_entropy preserialized;
+		net_messages::preserialize(preserialized, sent);
+
+		for (std::size_t c = 0; c < num_clients; ++c) {
+			sent.context.num_entropies_accepted = static_cast<uint8_t>(c);
+			ss.write_payload(sent.context, preserialized);
+		}
+	}
+
+	const auto broadcast_ms = t.extract<std::chrono::milliseconds>();
+
+	LOG(
+		"Step entropy serialization for %x clients, per tick: %x us when serialized per client, %x us when serialized once.",
+		num_clients,
+		per_client_ms * 1000 / num_ticks,
+		broadcast_ms * 1000 / num_ticks
+	);
+}
+
 TEST_CASE("NetSerialization ClientEntropy") {
 	net_messages::client_entropy ss;
 	ss.Release();
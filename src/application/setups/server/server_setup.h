@@ -23,6 +23,7 @@
 #include "augs/misc/serialization_buffers.h"
 
 #include "application/network/server_step_entropy.h"
+#include "application/network/special_client_request.h"
 #include "view/mode_gui/arena/arena_gui_mixin.h"
 #include "application/network/network_common.h"
 
@@ -74,6 +75,15 @@ class server_setup :
 
 	augs::serialization_buffers buffers;
 
+	initial_arena_baseline arena_baseline;
+
+	preserialized_initial_arena_state initial_state_snapshot;
+	std::optional<server_step_type> initial_state_snapshot_step;
+
+	/* For the clients whose arena baseline differs from ours. */
+	preserialized_initial_arena_state whole_initial_state_snapshot;
+	std::optional<server_step_type> whole_initial_state_snapshot_step;
+
 	entropy_accumulator local_collected;
 	compact_server_step_entropy step_collected;
 	bool reinference_necessary = false;
@@ -104,6 +114,9 @@ class server_setup :
 		};
 	}
 
+	preserialized_initial_arena_state& get_initial_state_snapshot(bool against_baseline);
+	preserialized_initial_arena_state& get_initial_state_snapshot_for(const server_client_state&);
+
 	void handle_client_messages();
 	void advance_clients_state();
 	void send_server_step_entropies(const compact_server_step_entropy& total);
@@ -130,6 +143,20 @@ class server_setup :
 	void reinfer_if_necessary_for(const compact_server_step_entropy& entropy);
 
 public:
+	/* Returns false if the client should be kicked for the request. */
+	static bool accept_initial_state_request(
+		special_client_request,
+		server_client_state&,
+		const server_vars&,
+		net_time_t server_time,
+		bool& reinference_necessary
+	);
+
+	static networked_server_step_entropy make_networked_step_entropy(
+		const compact_server_step_entropy&,
+		bool reinference_necessary
+	);
+
 	static constexpr auto loading_strategy = viewables_loading_type::LOAD_ALL;
 	static constexpr bool handles_window_input = true;
 	static constexpr bool has_additional_highlights = false;
@@ -246,6 +273,7 @@ public:
 			server_time += get_inv_tickrate();
 
 			update_stats(in.server_stats);
+			update_stats(in.network_performance);
 			step_collected.clear();
 		}
 	}
@@ -284,7 +312,12 @@ public:
 
 	void sleep_until_next_tick();
 
+	net_time_t get_next_tick_time() const {
+		return server_time;
+	}
+
 	void update_stats(server_network_info&) const;
+	void update_stats(network_profiler&) const;
 
 	server_step_entropy unpack(const compact_server_step_entropy&) const;
 };
@@ -0,0 +1,121 @@
+#include "augs/filesystem/mapped_file.h"
+
+#if PLATFORM_WINDOWS
+#include <Windows.h>
+#undef min
+#undef max
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace augs {
+#if PLATFORM_WINDOWS
+	mapped_file::mapped_file(const path_type& path) {
+		const auto file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+		if (file == INVALID_HANDLE_VALUE) {
+			throw mapped_file_error("Failed to open %x for mapping.", path);
+		}
+
+		file_handle = file;
+
+		LARGE_INTEGER file_size;
+
+		if (!GetFileSizeEx(file, &file_size)) {
+			close();
+			throw mapped_file_error("Failed to get the size of %x.", path);
+		}
+
+		mapped_size = static_cast<std::size_t>(file_size.QuadPart);
+
+		if (mapped_size == 0) {
+			return;
+		}
+
+		mapping_handle = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+		if (mapping_handle == nullptr) {
+			close();
+			throw mapped_file_error("Failed to map %x.", path);
+		}
+
+		mapped = reinterpret_cast<const std::byte*>(MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0));
+
+		if (mapped == nullptr) {
+			close();
+			throw mapped_file_error("Failed to map a view of %x.", path);
+		}
+	}
+
+	void mapped_file::close() {
+		if (mapped != nullptr) {
+			UnmapViewOfFile(mapped);
+		}
+
+		if (mapping_handle != nullptr) {
+			CloseHandle(mapping_handle);
+		}
+
+		if (file_handle != nullptr) {
+			CloseHandle(file_handle);
+		}
+
+		mapped = nullptr;
+		mapping_handle = nullptr;
+		file_handle = nullptr;
+	}
+#else
+	mapped_file::mapped_file(const path_type& path) {
+		descriptor = ::open(path.string().c_str(), O_RDONLY);
+
+		if (descriptor == -1) {
+			throw mapped_file_error("Failed to open %x for mapping.", path);
+		}
+
+		struct stat file_stat;
+
+		if (::fstat(descriptor, &file_stat) == -1) {
+			close();
+			throw mapped_file_error("Failed to get the size of %x.", path);
+		}
+
+		mapped_size = static_cast<std::size_t>(file_stat.st_size);
+
+		if (mapped_size == 0) {
+			return;
+		}
+
+		void* const view = ::mmap(nullptr, mapped_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+
+		if (view == MAP_FAILED) {
+			close();
+			throw mapped_file_error("Failed to map %x.", path);
+		}
+
+		/* The whole file will be read front to back. */
+		::madvise(view, mapped_size, MADV_SEQUENTIAL);
+
+		mapped = reinterpret_cast<const std::byte*>(view);
+	}
+
+	void mapped_file::close() {
+		if (mapped != nullptr) {
+			::munmap(const_cast<std::byte*>(mapped), mapped_size);
+		}
+
+		if (descriptor != -1) {
+			::close(descriptor);
+		}
+
+		mapped = nullptr;
+		descriptor = -1;
+	}
+#endif
+
+	mapped_file::~mapped_file() {
+		close();
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+
+#include "augs/filesystem/path.h"
+#include "augs/templates/exception_templates.h"
+
+namespace augs {
+	struct mapped_file_error : error_with_typesafe_sprintf {
+		using error_with_typesafe_sprintf::error_with_typesafe_sprintf;
+	};
+
+	/*
+		A read-only view of a whole file mapped into memory.
+		The pages are only read from the disk once they are touched,
+		and the operating system can share them with its file cache instead of copying.
+	*/
+
+	class mapped_file {
+		const std::byte* mapped = nullptr;
+		std::size_t mapped_size = 0;
+
+#if PLATFORM_WINDOWS
+		void* file_handle = nullptr;
+		void* mapping_handle = nullptr;
+#else
+		int descriptor = -1;
+#endif
+
+		void close();
+
+	public:
+		mapped_file(const path_type& path);
+		~mapped_file();
+
+		mapped_file(const mapped_file&) = delete;
+		mapped_file& operator=(const mapped_file&) = delete;
+
+		const std::byte* data() const {
+			return mapped;
+		}
+
+		std::size_t size() const {
+			return mapped_size;
+		}
+	};
+}
@@ -9,6 +9,9 @@ namespace augs {
 
 	template <unsigned const_count>
 	class constant_size_string;
+
+	template <class T, unsigned page_size>
+	class paged_vector;
 }
 
 template <unsigned I>
@@ -18,4 +21,9 @@ struct of_size {
 
 	template <class T>
 	using make_nontrivial_constant_vector = augs::constant_size_vector<T, I, true>;
-};
\ No newline at end of file
+};
+template <unsigned I>
+struct of_page_size {
+	template <class T>
+	using make_paged_vector = augs::paged_vector<T, I>;
+};
@@ -1,4 +1,68 @@
-#include "measurements.h"
-namespace augs {
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/measurements.h"
 
-}
\ No newline at end of file
+TEST_CASE("Measurements PercentileOfEmpty") {
+	augs::amount_measurements<double> m = 10;
+
+	REQUIRE(m.get_percentile_units(0.0) == 0.0);
+	REQUIRE(m.get_percentile_units(0.5) == 0.0);
+	REQUIRE(m.get_percentile_units(1.0) == 0.0);
+}
+
+TEST_CASE("Measurements PercentileOfSingleSample") {
+	augs::amount_measurements<double> m = 10;
+	m.measure(100.0);
+
+	/* Every percentile of a single sample falls into its bucket, which spans 1/8 of an octave. */
+	const auto bucket_width = std::exp2(1.0 / 8);
+
+	for (const auto p : { 0.0, 0.5, 0.95, 1.0 }) {
+		const auto v = m.get_percentile_units(p);
+
+		REQUIRE(v >= 100.0 / bucket_width);
+		REQUIRE(v <= 100.0 * bucket_width);
+	}
+}
+
+TEST_CASE("Measurements PercentileInterpolation") {
+	augs::amount_measurements<double> m = 4;
+
+	/* All four samples land in the same bucket, spanning [2^(4/8), 2^(5/8)]. */
+	for (int i = 0; i < 4; ++i) {
+		m.measure(1.5);
+	}
+
+	const auto lower = std::exp2(4.0 / 8);
+	const auto upper = std::exp2(5.0 / 8);
+
+	REQUIRE(m.get_percentile_units(0.25) == Approx(lower + (upper - lower) * 0.25));
+	REQUIRE(m.get_percentile_units(0.5) == Approx(lower + (upper - lower) * 0.5));
+	REQUIRE(m.get_percentile_units(1.0) == Approx(upper));
+}
+
+TEST_CASE("Measurements PercentileAcrossBuckets") {
+	augs::amount_measurements<double> m = 100;
+
+	for (int i = 1; i <= 100; ++i) {
+		m.measure(static_cast<double>(i));
+	}
+
+	const auto tolerance = std::exp2(1.0 / 8);
+
+	for (const auto p : { 0.5, 0.95, 0.99 }) {
+		const auto exact = p * 100;
+		const auto v = m.get_percentile_units(p);
+
+		REQUIRE(v >= exact / tolerance);
+		REQUIRE(v <= exact * tolerance);
+	}
+
+	/* Only the window counts. */
+	for (int i = 0; i < 100; ++i) {
+		m.measure(1000.0);
+	}
+
+	REQUIRE(m.get_percentile_units(0.5) >= 1000.0 / tolerance);
+}
+#endif
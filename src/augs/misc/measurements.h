@@ -1,52 +1,119 @@
 #pragma once
+#include <cmath>
+#include <algorithm>
+#include <limits>
 #include <string>
+#include <vector>
 
 #include "augs/ensure.h"
 #include "augs/math/vec2.h"
 #include "augs/templates/algorithm_templates.h"
 #include "augs/misc/timing/timer.h"
 #include "augs/misc/scope_guard.h"
+#include "augs/misc/trace_recording.h"
 
 namespace augs {
+	/*
+		Tracks the last N samples in a ring buffer.
+
+		Recording a sample is O(1): the sum is updated incrementally
+		and the samples of the window are also counted in logarithmic buckets (8 per octave),
+		so percentiles can be read by walking the buckets instead of sorting the window.
+		Percentiles are thus approximate - they are interpolated linearly within their bucket.
+	*/
+
 	template <class derived, class T = double>
 	class measurements {
+		static constexpr bool has_percentiles = std::is_arithmetic_v<T>;
+
+		static constexpr std::size_t buckets_per_octave = 8;
+		static constexpr std::size_t num_octaves = 24;
+		static constexpr std::size_t num_buckets = 1 + buckets_per_octave * num_octaves;
+
+		static std::size_t bucket_of(const T value) {
+			const auto units = static_cast<double>(value) / derived::histogram_unit;
+
+			if (!(units > 1.0)) {
+				return 0;
+			}
+
+			const auto bucket = 1 + static_cast<std::size_t>(std::log2(units) * buckets_per_octave);
+			return std::min(bucket, num_buckets - 1);
+		}
+
+		static double upper_bound_of(const std::size_t bucket) {
+			if (bucket == 0) {
+				return 0.0;
+			}
+
+			return derived::histogram_unit * std::exp2(static_cast<double>(bucket) / buckets_per_octave);
+		}
+
 	protected:
 		std::size_t measurement_index = 0;
+		std::size_t num_samples = 0;
 
-		T last_average = T();
-		T last_minimum = T();
-		T last_maximum = T();
+		T running_sum = T();
 		T last_measurement = T();
 
 		bool measured = false;
 
+		std::vector<unsigned short> histogram;
+
 	public:
 		std::string title = "Untitled";
 		std::vector<T> tracked;
 
 		measurements(const std::size_t tracked_count = 20u) {
+			set_window(tracked_count);
+		}
+
+		void set_window(const std::size_t tracked_count) {
 			/* A value of 0 would cause division by 0. */
 			ensure_greater(tracked_count, 0);
-			tracked.resize(tracked_count);
+			ensure_leq(tracked_count, std::size_t(std::numeric_limits<unsigned short>::max()));
+
+			tracked.assign(tracked_count, T());
+			histogram.assign(has_percentiles ? num_buckets : 0, 0);
+
+			measurement_index = 0;
+			num_samples = 0;
+			running_sum = T();
 		}
 
 		void measure(const T value) {
 			measured = true;
 			last_measurement = value;
 
-			tracked[measurement_index] = last_measurement;
-			++measurement_index;
-			measurement_index %= tracked.size();
+			auto& slot = tracked[measurement_index];
 
-			T avg = T();
+			if constexpr(has_percentiles) {
+				if (num_samples == tracked.size()) {
+					--histogram[bucket_of(slot)];
+				}
 
-			for (auto v : tracked) {
-				avg += v;
+				++histogram[bucket_of(value)];
 			}
 
-			last_average = avg / static_cast<unsigned>(tracked.size());
-			last_maximum = maximum_of(tracked);
-			last_minimum = minimum_of(tracked);
+			running_sum -= slot;
+			running_sum += value;
+			slot = value;
+
+			num_samples = std::min(num_samples + 1, tracked.size());
+
+			++measurement_index;
+
+			if (measurement_index == tracked.size()) {
+				measurement_index = 0;
+
+				/* Sum it anew once per window so that floating point errors do not accumulate. */
+
+				running_sum = T();
+
+				for (const auto& v : tracked) {
+					running_sum += v;
+				}
+			}
 		}
 
 		std::string summary() const {
@@ -67,15 +134,52 @@ namespace augs {
 		}
 
 		T get_average_units() const {
-			return last_average;
+			return running_sum / static_cast<unsigned>(tracked.size());
 		}
 
 		T get_maximum_units() const {
-			return last_maximum;
+			return maximum_of(tracked);
 		}
 
 		T get_minimum_units() const {
-			return last_minimum;
+			return minimum_of(tracked);
+		}
+
+		/* 
+			p is within [0, 1].
+			Walks the buckets only, so the cost does not depend on the size of the window.
+		*/
+
+		T get_percentile_units(const double p) const {
+			static_assert(has_percentiles, "Percentiles are only tracked for arithmetic types.");
+
+			if (num_samples == 0) {
+				return T();
+			}
+
+			const auto rank = std::clamp(
+				static_cast<std::size_t>(std::ceil(p * num_samples)),
+				std::size_t(1),
+				num_samples
+			);
+
+			std::size_t seen = 0;
+
+			for (std::size_t b = 0; b < num_buckets; ++b) {
+				const auto in_bucket = static_cast<std::size_t>(histogram[b]);
+
+				if (seen + in_bucket >= rank) {
+					const auto lower = b == 0 ? 0.0 : upper_bound_of(b - 1);
+					const auto upper = upper_bound_of(b);
+					const auto fraction = static_cast<double>(rank - seen) / in_bucket;
+
+					return static_cast<T>(lower + (upper - lower) * fraction);
+				}
+
+				seen += in_bucket;
+			}
+
+			return static_cast<T>(upper_bound_of(num_buckets - 1));
 		}
 
 		T get_last_measurement_units() const {
@@ -92,6 +196,8 @@ namespace augs {
 		using base = measurements<amount_measurements<T>, T>;
 		friend base;
 
+		static constexpr double histogram_unit = 1.0;
+
 		auto summary_impl() const {
 			return typesafe_sprintf("%x: %f2\n", base::title, base::get_average_units());
 		}
@@ -107,23 +213,36 @@ namespace augs {
 		using base = measurements<time_measurements, double>;
 		friend base;
 
+		/* Buckets start at a microsecond. */
+		static constexpr double histogram_unit = 0.000001;
+
 		auto summary_impl() const {
 			const auto avg_secs = get_average_units();
 			const bool division_by_secs_safe = std::abs(avg_secs) > AUGS_EPSILON<double>;
 
+			const auto tail = tracked.size() > 1 ? typesafe_sprintf(
+				" [p50: %f2, p95: %f2, p99: %f2, max: %f2]",
+				get_percentile_units(0.5) * 1000,
+				get_percentile_units(0.95) * 1000,
+				get_percentile_units(0.99) * 1000,
+				get_maximum_units() * 1000
+			) : std::string();
+
 			if (division_by_secs_safe) {
 				return typesafe_sprintf(
-					"%x: %f2 ms (%f2 FPS)\n", 
+					"%x: %f2 ms (%f2 FPS)%x\n", 
 					title,
 					avg_secs * 1000,
-					1 / avg_secs
+					1 / avg_secs,
+					tail
 				);
 			}
 			else {
 				return typesafe_sprintf(
-					"%x: %f2 ms\n", 
+					"%x: %f2 ms%x\n", 
 					title,
-					avg_secs * 1000
+					avg_secs * 1000,
+					tail
 				);
 			}
 		}
@@ -138,7 +257,12 @@ namespace augs {
 		}
 
 		void stop() {
-			measure(tm.get<std::chrono::seconds>());
+			const auto secs = tm.get<std::chrono::seconds>();
+			measure(secs);
+
+			if (is_trace_recording()) {
+				record_trace_interval(title, secs);
+			}
 		}
 	};
 
@@ -0,0 +1,99 @@
+#include <algorithm>
+
+#include "augs/misc/packed_snapshot.h"
+#include "augs/misc/compress.h"
+
+namespace augs {
+	static packed_snapshot pack(const std::vector<std::byte>& bytes, const bool keyframe) {
+		thread_local auto compression_state = make_compression_state();
+
+		packed_snapshot result;
+		result.keyframe = keyframe;
+		result.uncompressed_size = static_cast<uint32_t>(bytes.size());
+
+		compress(compression_state, bytes, result.compressed);
+		result.compressed.shrink_to_fit();
+
+		return result;
+	}
+
+	packed_snapshot pack_keyframe(const std::vector<std::byte>& bytes) {
+		return pack(bytes, true);
+	}
+
+	packed_snapshot pack_delta(
+		const std::vector<std::byte>& bytes,
+		const std::vector<std::byte>& previous
+	) {
+		thread_local std::vector<std::byte> diff;
+
+		diff = bytes;
+
+		const auto common = std::min(diff.size(), previous.size());
+
+		for (std::size_t i = 0; i < common; ++i) {
+			diff[i] ^= previous[i];
+		}
+
+		return pack(diff, false);
+	}
+
+	void unpack_snapshot(const packed_snapshot& packed, std::vector<std::byte>& bytes) {
+		thread_local std::vector<std::byte> unpacked;
+
+		unpacked.resize(packed.uncompressed_size);
+		decompress(packed.compressed, unpacked);
+
+		if (!packed.keyframe) {
+			const auto common = std::min(unpacked.size(), bytes.size());
+
+			for (std::size_t i = 0; i < common; ++i) {
+				unpacked[i] ^= bytes[i];
+			}
+		}
+
+		bytes.swap(unpacked);
+	}
+}
+
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+
+TEST_CASE("Ca PackedSnapshotDeltas") {
+	auto make_bytes = [](const std::size_t n, const int seed) {
+		std::vector<std::byte> out(n);
+
+		for (std::size_t i = 0; i < n; ++i) {
+			out[i] = static_cast<std::byte>((i * 31 + seed * ((i % 97) == 0)) & 0xff);
+		}
+
+		return out;
+	};
+
+	const auto first = make_bytes(10000, 1);
+	const auto same_size = make_bytes(10000, 2);
+	const auto grown = make_bytes(12000, 3);
+	const auto shrunk = make_bytes(500, 4);
+
+	const auto key = augs::pack_keyframe(first);
+	const auto d1 = augs::pack_delta(same_size, first);
+	const auto d2 = augs::pack_delta(grown, same_size);
+	const auto d3 = augs::pack_delta(shrunk, grown);
+
+	std::vector<std::byte> bytes;
+
+	augs::unpack_snapshot(key, bytes);
+	REQUIRE(bytes == first);
+
+	augs::unpack_snapshot(d1, bytes);
+	REQUIRE(bytes == same_size);
+
+	augs::unpack_snapshot(d2, bytes);
+	REQUIRE(bytes == grown);
+
+	augs::unpack_snapshot(d3, bytes);
+	REQUIRE(bytes == shrunk);
+
+	REQUIRE(d1.compressed.size() < key.compressed.size());
+}
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+namespace augs {
+	/*
+		A snapshot of the player, compressed with lz4.
+
+		A keyframe stores the whole snapshot.
+		A delta stores the XOR of the snapshot with the one preceding it,
+		so that all bytes which did not change become zeros - which compress extremely well.
+	*/
+
+	struct packed_snapshot {
+		// GEN INTROSPECTOR struct augs::packed_snapshot
+		bool keyframe = true;
+		uint32_t uncompressed_size = 0;
+		std::vector<std::byte> compressed;
+		// END GEN INTROSPECTOR
+	};
+
+	packed_snapshot pack_keyframe(const std::vector<std::byte>& bytes);
+
+	packed_snapshot pack_delta(
+		const std::vector<std::byte>& bytes,
+		const std::vector<std::byte>& previous
+	);
+
+	/* For a delta, "bytes" must hold the preceding snapshot on input. */
+	void unpack_snapshot(const packed_snapshot&, std::vector<std::byte>& bytes);
+}
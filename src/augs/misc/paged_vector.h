@@ -0,0 +1,352 @@
+#pragma once
+#include <new>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <cstring>
+#include <iterator>
+#include <algorithm>
+#include <type_traits>
+
+#include "augs/ensure.h"
+#include "augs/misc/declare_containers.h"
+
+namespace augs {
+	/*
+		A vector that keeps its elements in fixed-size pages instead of a single contiguous block.
+
+		Allocated pages never move, so growing never relocates the existing elements.
+		Pages stay allocated after the elements are removed, so they can be reused without allocating again.
+
+		A copy only allocates and copies the pages needed for the live elements,
+		no matter how much the source has reserved.
+	*/
+
+	template <class T, unsigned page_size>
+	class paged_vector {
+		static_assert(page_size > 0 && (page_size & (page_size - 1)) == 0, "Page size must be a power of two.");
+
+	public:
+		using value_type = T;
+
+		struct page_type {
+			std::aligned_storage_t<sizeof(T), alignof(T)> raw[page_size];
+		};
+
+	private:
+		static constexpr bool is_trivially_copyable = std::is_trivially_copyable_v<value_type>;
+
+		std::vector<std::unique_ptr<page_type>> pages;
+		std::size_t count = 0;
+
+		static auto pages_for(const std::size_t n) {
+			return (n + page_size - 1) / page_size;
+		}
+
+		auto* nth_ptr(const std::size_t n) {
+			return std::launder(reinterpret_cast<T*>(pages[n / page_size]->raw + n % page_size));
+		}
+
+		const auto* nth_ptr(const std::size_t n) const {
+			return std::launder(reinterpret_cast<const T*>(pages[n / page_size]->raw + n % page_size));
+		}
+
+		void allocate_pages_for(const std::size_t n) {
+			const auto needed = pages_for(n);
+
+			if (needed > pages.size()) {
+				pages.reserve(needed);
+
+				while (pages.size() < needed) {
+					/* Default-initialized, so that the storage is not needlessly zeroed. */
+					pages.emplace_back(new page_type);
+				}
+			}
+		}
+
+		template <class... Args>
+		void construct_at(const std::size_t n, Args&&... args) {
+			new (pages[n / page_size]->raw + n % page_size) value_type(std::forward<Args>(args)...);
+		}
+
+		void _pop_back() {
+			--count;
+
+			if constexpr(!is_trivially_copyable) {
+				nth_ptr(count)->~value_type();
+			}
+		}
+
+		template <class S, class V>
+		class basic_iterator {
+			friend paged_vector;
+
+			S* self = nullptr;
+			std::size_t n = 0;
+
+			basic_iterator(S* self, const std::size_t n) : self(self), n(n) {}
+
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = std::remove_const_t<V>;
+			using difference_type = std::ptrdiff_t;
+			using pointer = V*;
+			using reference = V&;
+
+			basic_iterator() = default;
+
+			V& operator*() const {
+				return (*self)[n];
+			}
+
+			V* operator->() const {
+				return std::addressof(operator*());
+			}
+
+			basic_iterator& operator++() {
+				++n;
+				return *this;
+			}
+
+			basic_iterator operator++(int) {
+				auto old = *this;
+				++n;
+				return old;
+			}
+
+			bool operator==(const basic_iterator& b) const {
+				return n == b.n;
+			}
+
+			bool operator!=(const basic_iterator& b) const {
+				return n != b.n;
+			}
+		};
+
+	public:
+		using iterator = basic_iterator<paged_vector, value_type>;
+		using const_iterator = basic_iterator<const paged_vector, const value_type>;
+
+		paged_vector() = default;
+
+		paged_vector(const paged_vector& b) {
+			*this = b;
+		}
+
+		paged_vector& operator=(const paged_vector& b) {
+			if (this == std::addressof(b)) {
+				return *this;
+			}
+
+			clear();
+			allocate_pages_for(b.count);
+
+			if constexpr(is_trivially_copyable) {
+				b.for_each_page([this, i = std::size_t(0)](const value_type* const first, const std::size_t n) mutable {
+					std::memcpy(pages[i++]->raw, first, n * sizeof(value_type));
+				});
+			}
+			else {
+				for (std::size_t i = 0; i < b.count; ++i) {
+					construct_at(i, b[i]);
+				}
+			}
+
+			count = b.count;
+			return *this;
+		}
+
+		paged_vector(paged_vector&& b) noexcept : pages(std::move(b.pages)), count(b.count) {
+			b.pages.clear();
+			b.count = 0;
+		}
+
+		paged_vector& operator=(paged_vector&& b) noexcept {
+			if (this == std::addressof(b)) {
+				return *this;
+			}
+
+			clear();
+
+			pages = std::move(b.pages);
+			count = b.count;
+
+			b.pages.clear();
+			b.count = 0;
+
+			return *this;
+		}
+
+		~paged_vector() {
+			clear();
+		}
+
+		void push_back(const value_type& obj) {
+			emplace_back(obj);
+		}
+
+		void push_back(value_type&& obj) {
+			emplace_back(std::move(obj));
+		}
+
+		template <class... Args>
+		value_type& emplace_back(Args&&... args) {
+			allocate_pages_for(count + 1);
+			construct_at(count, std::forward<Args>(args)...);
+			return *nth_ptr(count++);
+		}
+
+		void pop_back() {
+			ensure_greater(count, 0);
+			_pop_back();
+		}
+
+		value_type& operator[](const std::size_t i) {
+#if !IS_PRODUCTION_BUILD
+			ensure_less(i, count);
+#endif
+			return *nth_ptr(i);
+		}
+
+		const value_type& operator[](const std::size_t i) const {
+#if !IS_PRODUCTION_BUILD
+			ensure_less(i, count);
+#endif
+			return *nth_ptr(i);
+		}
+
+		value_type& at(const std::size_t i) {
+			return operator[](i);
+		}
+
+		const value_type& at(const std::size_t i) const {
+			return operator[](i);
+		}
+
+		value_type& front() {
+			return *nth_ptr(0);
+		}
+
+		const value_type& front() const {
+			return *nth_ptr(0);
+		}
+
+		value_type& back() {
+			return *nth_ptr(count - 1);
+		}
+
+		const value_type& back() const {
+			return *nth_ptr(count - 1);
+		}
+
+		iterator erase(const iterator first, const iterator last) {
+			ensure_leq(first.n, last.n);
+			ensure_leq(last.n, count);
+
+			const auto removed = last.n - first.n;
+
+			for (std::size_t i = last.n; i < count; ++i) {
+				(*this)[i - removed] = std::move((*this)[i]);
+			}
+
+			for (std::size_t i = 0; i < removed; ++i) {
+				_pop_back();
+			}
+
+			return first;
+		}
+
+		void resize_no_init(const std::size_t s) {
+			static_assert(is_trivially_copyable);
+			allocate_pages_for(s);
+			count = s;
+		}
+
+		void resize(const std::size_t s) {
+			allocate_pages_for(s);
+
+			while (count < s) {
+				new (pages[count / page_size]->raw + count % page_size) value_type;
+				++count;
+			}
+
+			while (count > s) {
+				_pop_back();
+			}
+		}
+
+		void reserve(const std::size_t s) {
+			allocate_pages_for(s);
+		}
+
+		void clear() {
+			if constexpr(!is_trivially_copyable) {
+				while (count) {
+					_pop_back();
+				}
+			}
+			else {
+				count = 0;
+			}
+		}
+
+		/* Also frees the pages. */
+		void shrink_to_fit() {
+			pages.resize(pages_for(count));
+			pages.shrink_to_fit();
+		}
+
+		/* Calls back with each contiguous run of live elements. */
+
+		template <class F>
+		void for_each_page(F&& callback) {
+			for (std::size_t first = 0; first < count; first += page_size) {
+				callback(nth_ptr(first), std::min(count - first, static_cast<std::size_t>(page_size)));
+			}
+		}
+
+		template <class F>
+		void for_each_page(F&& callback) const {
+			for (std::size_t first = 0; first < count; first += page_size) {
+				callback(nth_ptr(first), std::min(count - first, static_cast<std::size_t>(page_size)));
+			}
+		}
+
+		auto begin() {
+			return iterator(this, 0);
+		}
+
+		auto end() {
+			return iterator(this, count);
+		}
+
+		auto begin() const {
+			return const_iterator(this, 0);
+		}
+
+		auto end() const {
+			return const_iterator(this, count);
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+
+		std::size_t capacity() const {
+			return pages.size() * page_size;
+		}
+
+		std::size_t num_pages() const {
+			return pages.size();
+		}
+
+		/* Not constexpr on purpose - the limit is imposed by the index type of whoever uses this. */
+		std::size_t max_size() const {
+			return std::numeric_limits<unsigned>::max();
+		}
+
+		bool empty() const {
+			return count == 0;
+		}
+	};
+}
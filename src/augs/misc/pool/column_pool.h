@@ -0,0 +1,163 @@
+#pragma once
+#include <tuple>
+#include <utility>
+
+#include "augs/templates/type_list.h"
+#include "augs/templates/folded_finders.h"
+#include "augs/templates/remove_cref.h"
+#include "augs/templates/transform_types.h"
+#include "augs/misc/pool/pool.h"
+#include "augs/misc/pool/pool_declaration.h"
+
+namespace augs {
+	/*
+		A pool that keeps some values of its objects outside of them,
+		in densely packed arrays - "columns" - that run in parallel to the array of objects.
+		The n-th value of every column belongs to the n-th object,
+		so the real index of an object is also its index into the columns.
+
+		Iterating over a single column only touches the memory of that column,
+		instead of dragging whole objects through the cache.
+
+		Every operation that moves objects around moves the column values the same way.
+		With an empty column list, this behaves exactly like the plain pool.
+	*/
+
+	template <class T, class ColumnList, template <class> class make_container_type, class size_type, class... id_keys>
+	class column_pool : public pool<T, make_container_type, size_type, id_keys...> {
+		using base = pool<T, make_container_type, size_type, id_keys...>;
+
+		template <class C>
+		using make_column = make_container_type<C>;
+
+		using columns_type = replace_list_type_t<transform_types_in_list_t<ColumnList, make_column>, std::tuple>;
+
+		columns_type columns;
+
+		template <class S, class F>
+		static void for_each_column_impl(S& self, F&& callback) {
+			std::apply([&callback](auto&... column) { (callback(column), ...); }, self.columns);
+		}
+
+	public:
+		using column_list = ColumnList;
+
+		using typename base::key_type;
+		using typename base::unversioned_id_type;
+		using typename base::undo_free_input_type;
+		using typename base::allocation_result;
+
+		column_pool(const size_type slot_count = 0u) {
+			reserve(slot_count);
+		}
+
+		template <class C>
+		static constexpr bool has_column() {
+			return is_one_of_list_v<C, ColumnList>;
+		}
+
+		template <class C>
+		auto& get_column() {
+			static_assert(has_column<C>(), "No such column in the pool.");
+			return std::get<make_column<C>>(columns);
+		}
+
+		template <class C>
+		const auto& get_column() const {
+			static_assert(has_column<C>(), "No such column in the pool.");
+			return std::get<make_column<C>>(columns);
+		}
+
+		/* Only valid for the objects that live inside this pool, and only if they are stored contiguously. */
+		size_type index_of(const T& object) const {
+			return static_cast<size_type>(std::addressof(object) - this->data());
+		}
+
+		/* Only valid for the keys of live objects. */
+		size_type index_of(const key_type key) const {
+			return this->get_indirector(key).real_index;
+		}
+
+		template <class F>
+		void for_each_column(F&& callback) {
+			for_each_column_impl(*this, std::forward<F>(callback));
+		}
+
+		template <class F>
+		void for_each_column(F&& callback) const {
+			for_each_column_impl(*this, std::forward<F>(callback));
+		}
+
+		void reserve(const size_type new_capacity) {
+			base::reserve(new_capacity);
+
+			for_each_column([new_capacity](auto& column) {
+				column.reserve(new_capacity);
+			});
+		}
+
+		template <
+			unsigned expansion_mult = 2,
+			unsigned expansion_add = 1,
+			class... Args
+		>
+		allocation_result allocate(Args&&... args);
+		void undo_last_allocate(const key_type key);
+
+		auto free(const unversioned_id_type key);
+
+		auto free(const key_type key) -> std::optional<undo_free_input_type>;
+
+		/* Column values of the restored object are value-initialized. */
+		template <class... Args>
+		allocation_result undo_free(
+			const undo_free_input_type in,
+			Args&&... removed_content
+		);
+
+		void clear() {
+			base::clear();
+
+			for_each_column([](auto& column) {
+				column.clear();
+			});
+		}
+
+		template <class Archive>
+		void write_object_bytes(Archive& ar) const;
+
+		template <class Archive>
+		void read_object_bytes(Archive& ar);
+
+		template <class Archive>
+		void write_object_lua(Archive& ar) const;
+
+		template <class Archive>
+		void read_object_lua(const Archive& ar);
+	};
+
+	template <class M, class L, template <class> class C, class S, class... K>
+	struct is_pool<column_pool<M, L, C, S, K...>> : std::true_type {};
+}
+
+namespace augs {
+	template <class A, class M, class L, template <class> class C, class S, class... K>
+	void read_object_bytes(A& ar, column_pool<M, L, C, S, K...>& storage) {
+		storage.read_object_bytes(ar);
+	}
+
+	template <class A, class M, class L, template <class> class C, class S, class... K>
+	void write_object_bytes(A& ar, const column_pool<M, L, C, S, K...>& storage) {
+		storage.write_object_bytes(ar);
+	}
+
+	template <class A, class M, class L, template <class> class C, class S, class... K>
+	void read_object_lua(const A& ar, column_pool<M, L, C, S, K...>& storage) {
+		storage.read_object_lua(ar);
+	}
+
+	template <class A, class M, class L, template <class> class C, class S, class... K>
+	void write_object_lua(A& ar, const column_pool<M, L, C, S, K...>& storage) {
+		storage.write_object_lua(ar);
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+#include "augs/misc/pool/column_pool.h"
+#include "augs/misc/pool/pool_allocate.h"
+
+namespace augs {
+	template <class T, class L, template <class> class M, class size_type, class... K>
+	template <
+		unsigned expansion_mult, 
+		unsigned expansion_add, 
+		class... Args
+	>
+	typename column_pool<T, L, M, size_type, K...>::allocation_result column_pool<T, L, M, size_type, K...>::allocate(Args&&... args) {
+		const auto result = base::template allocate<expansion_mult, expansion_add>(std::forward<Args>(args)...);
+
+		for_each_column([](auto& column) {
+			column.emplace_back();
+		});
+
+		return result;
+	}
+
+	template <class T, class L, template <class> class M, class size_type, class... K>
+	void column_pool<T, L, M, size_type, K...>::undo_last_allocate(const key_type key) {
+		const auto size_before = this->size();
+
+		base::undo_last_allocate(key);
+
+		if (this->size() != size_before) {
+			for_each_column([](auto& column) {
+				column.pop_back();
+			});
+		}
+	}
+
+	template <class T, class L, template <class> class M, class size_type, class... K>
+	auto column_pool<T, L, M, size_type, K...>::free(const key_type key) 
+		-> std::optional<undo_free_input_type>
+	{
+		const auto size_before = this->size();
+		const auto result = base::free(key);
+
+		if (result) {
+			const auto removed_at_index = result->real_index;
+			const auto last_index = static_cast<size_type>(size_before - 1);
+
+			/* Mirror the swap-with-last the base pool has just done. */
+
+			for_each_column([removed_at_index, last_index](auto& column) {
+				if (removed_at_index != last_index) {
+					column[removed_at_index] = std::move(column.back());
+				}
+
+				column.pop_back();
+			});
+		}
+
+		return result;
+	}
+
+	template <class T, class L, template <class> class M, class size_type, class... K>
+	auto column_pool<T, L, M, size_type, K...>::free(const unversioned_id_type key) {
+		return free(this->get_versioned(key));
+	}
+
+	template <class T, class L, template <class> class M, class size_type, class... K>
+	template <class... Args>
+	typename column_pool<T, L, M, size_type, K...>::allocation_result column_pool<T, L, M, size_type, K...>::undo_free(
+		const undo_free_input_type in,
+		Args&&... removed_content
+	) {
+		const auto size_before = this->size();
+		const auto real_index = in.real_index;
+
+		const auto result = base::undo_free(in, std::forward<Args>(removed_content)...);
+
+		/* Mirror how the base pool moves the object that took the place of the removed one back to the end. */
+
+		for_each_column([real_index, size_before](auto& column) {
+			using value_type = remove_cref<decltype(column[0])>;
+
+			if (real_index < size_before) {
+				auto moved = std::move(column[real_index]);
+				column.emplace_back(std::move(moved));
+				column[real_index] = value_type();
+			}
+			else {
+				column.emplace_back();
+			}
+		});
+
+		return result;
+	}
+}
@@ -3,7 +3,9 @@
 #include "augs/misc/pool/pool.h"
 #include "augs/misc/pool/pool_io.hpp"
 #include "augs/misc/pool/pool_allocate.h"
+#include "augs/misc/pool/column_pool_allocate.h"
 #include "augs/misc/constant_size_vector.h"
+#include "augs/misc/paged_vector.h"
 #include "augs/readwrite/readwrite_test_cycle.h"
 
 using p_t = augs::pool<int, of_size<6>::make_nontrivial_constant_vector, unsigned short>;
@@ -174,6 +176,124 @@ void test_pool() {
 TEST_CASE("Pool Readwrite") {
 	test_pool<augs::pool<float, of_size<100>::make_nontrivial_constant_vector, unsigned short>>();
 	test_pool<augs::pool<float, make_vector, unsigned char>>();
+	test_pool<augs::column_pool<float, type_list<int, double>, of_size<100>::make_nontrivial_constant_vector, unsigned short>>();
+	test_pool<augs::column_pool<float, type_list<int>, make_vector, unsigned char>>();
+	test_pool<augs::pool<float, of_page_size<4>::make_paged_vector, unsigned>>();
+	test_pool<augs::column_pool<float, type_list<int, double>, of_page_size<2>::make_paged_vector, unsigned>>();
+}
+
+TEST_CASE("Pool Paged") {
+	{
+		augs::paged_vector<int, 16> v;
+		v.reserve(1000);
+
+		for (int i = 0; i < 20; ++i) {
+			v.push_back(i);
+		}
+
+		REQUIRE(v.num_pages() == 63);
+
+		const auto copied = v;
+
+		/* Only the pages with live elements are copied. */
+		REQUIRE(copied.num_pages() == 2);
+		REQUIRE(copied.size() == 20);
+
+		for (int i = 0; i < 20; ++i) {
+			REQUIRE(copied[i] == i);
+		}
+
+		v.clear();
+		REQUIRE(v.num_pages() == 63);
+
+		v.shrink_to_fit();
+		REQUIRE(v.num_pages() == 0);
+	}
+
+	{
+		/* More objects than unsigned short could ever index. */
+		augs::pool<unsigned, of_page_size<1024>::make_paged_vector, unsigned> p;
+
+		const unsigned n = 100000;
+		std::vector<decltype(p)::key_type> keys;
+
+		for (unsigned i = 0; i < n; ++i) {
+			keys.push_back(p.allocate(i).key);
+		}
+
+		REQUIRE(p.size() == n);
+
+		for (unsigned i = 0; i < n; i += 2) {
+			p.free(keys[i]);
+		}
+
+		const auto copied = p;
+		REQUIRE(copied.size() == n / 2);
+
+		for (unsigned i = 0; i < n; ++i) {
+			if (i % 2) {
+				REQUIRE(copied.get(keys[i]) == i);
+			}
+			else {
+				REQUIRE(copied.find(keys[i]) == nullptr);
+			}
+		}
+	}
+}
+
+TEST_CASE("Pool ColumnsFollowObjects") {
+	using cp_t = augs::column_pool<unsigned, type_list<int, double>, of_size<6>::make_nontrivial_constant_vector, unsigned short>;
+
+	cp_t p = 6;
+	std::vector<cp_t::key_type> keys;
+
+	auto set_columns = [&p](const unsigned& object) {
+		const auto index = p.index_of(object);
+
+		p.get_column<int>()[index] = static_cast<int>(object) * 10;
+		p.get_column<double>()[index] = object * 100.0;
+	};
+
+	auto columns_match = [&]() {
+		REQUIRE(p.get_column<int>().size() == p.size());
+		REQUIRE(p.get_column<double>().size() == p.size());
+
+		for (const auto& key : keys) {
+			if (const auto object = p.find(key)) {
+				const auto index = p.index_of(*object);
+
+				REQUIRE(p.get_column<int>()[index] == static_cast<int>(*object) * 10);
+				REQUIRE(p.get_column<double>()[index] == *object * 100.0);
+			}
+		}
+	};
+
+	for (unsigned i = 0; i < 6; ++i) {
+		const auto result = p.allocate(i);
+		set_columns(result.object);
+		keys.push_back(result.key);
+	}
+
+	columns_match();
+
+	const auto undo_1 = *p.free(keys[1]);
+	columns_match();
+
+	const auto undo_3 = *p.free(keys[3]);
+	columns_match();
+
+	set_columns(p.undo_free(undo_3, 3u).object);
+	columns_match();
+
+	set_columns(p.undo_free(undo_1, 1u).object);
+	columns_match();
+
+	p.free(keys[5]);
+	p.undo_last_allocate(p.allocate(7u));
+	columns_match();
+
+	p.clear();
+	REQUIRE(p.get_column<int>().empty());
 }
 
 #endif
@@ -336,6 +336,14 @@ namespace augs {
 			return objects.end();
 		}
 
+		mapped_type& get_nth(const size_type i) {
+			return objects[i];
+		}
+
+		const mapped_type& get_nth(const size_type i) const {
+			return objects[i];
+		}
+
 		auto get_nth_id(const size_type i) const {
 			key_type id;
 
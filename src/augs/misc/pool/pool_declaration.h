@@ -5,6 +5,9 @@ namespace augs {
 	template <class M, template <class> class C, class S, class... K>
 	class pool;
 
+	template <class M, class L, template <class> class C, class S, class... K>
+	class column_pool;
+
 	template <class, class... K>
 	struct pooled_object_id;
 
@@ -1,5 +1,7 @@
 #pragma once
 #include "augs/misc/pool/pool.h"
+#include "augs/misc/pool/column_pool.h"
+#include "augs/string/get_type_name.h"
 
 #include "augs/readwrite/byte_readwrite_declaration.h"
 #include "augs/readwrite/lua_readwrite_declaration.h"
@@ -124,4 +126,91 @@ namespace augs {
 			}
 		}
 	}
+
+	/* Columns follow the base pool, in the order of the objects. */
+
+	template <class A, class L, template <class> class B, class C, class... D>
+	template <class Archive>
+	void column_pool<A, L, B, C, D...>::write_object_bytes(Archive& ar) const {
+		base::write_object_bytes(ar);
+
+		for_each_column([&ar](const auto& column) {
+			augs::write_capacity_bytes(ar, column);
+			augs::write_container_bytes(ar, column);
+		});
+	}
+
+	template <class A, class L, template <class> class B, class C, class... D>
+	template <class Archive>
+	void column_pool<A, L, B, C, D...>::read_object_bytes(Archive& ar) {
+		base::read_object_bytes(ar);
+
+		for_each_column([&ar](auto& column) {
+			augs::read_capacity_bytes(ar, column);
+			augs::read_container_bytes(ar, column);
+		});
+	}
+
+	template <class A, class L, template <class> class B, class C, class... D>
+	template <class Archive>
+	void column_pool<A, L, B, C, D...>::write_object_lua(Archive& into) const {
+		base::write_object_lua(into);
+
+		if constexpr(num_types_in_list_v<L> > 0) {
+			auto columns_table = into.create();
+
+			for_each_column([&](const auto& column) {
+				using value_type = remove_cref<decltype(column[0])>;
+
+				auto column_table = columns_table.create();
+
+				for (std::size_t i = 0; i < column.size(); ++i) {
+					write_table_or_field(column_table, column[i], static_cast<int>(i + 1));
+				}
+
+				columns_table[get_type_name_strip_namespace<value_type>()] = column_table;
+			});
+
+			into["columns"] = columns_table;
+		}
+	}
+
+	template <class A, class L, template <class> class B, class C, class... D>
+	template <class Archive>
+	void column_pool<A, L, B, C, D...>::read_object_lua(const Archive& from) {
+		base::read_object_lua(from);
+
+		auto columns_table = from["columns"];
+		const bool columns_specified = columns_table.valid();
+
+		for_each_column([&](auto& column) {
+			using value_type = remove_cref<decltype(column[0])>;
+
+			column.clear();
+
+			for (std::size_t i = 0; i < this->size(); ++i) {
+				column.emplace_back();
+			}
+
+			/* Values missing from the file are left default, e.g. if the column did not exist when it was written. */
+
+			if (!columns_specified) {
+				return;
+			}
+
+			auto column_table = columns_table[get_type_name_strip_namespace<value_type>()];
+
+			if (!column_table.valid()) {
+				return;
+			}
+
+			for (std::size_t i = 0; i < column.size(); ++i) {
+				auto value_entry = column_table[static_cast<int>(i + 1)];
+
+				if (value_entry.valid()) {
+					read_lua(value_entry, column[i]);
+				}
+			}
+		});
+	}
 }
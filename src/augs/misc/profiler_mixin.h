@@ -25,6 +25,18 @@ namespace augs {
 		}
 
 	public:
+		/* Calls back with the field name and the measurement itself. */
+
+		template <class F>
+		void for_each_measurement(F&& callback) {
+			for_each_measurement(std::forward<F>(callback), *static_cast<derived*>(this));
+		}
+
+		template <class F>
+		void for_each_measurement(F&& callback) const {
+			for_each_measurement(std::forward<F>(callback), *static_cast<const derived*>(this));
+		}
+
 		void setup_names_of_measurements() {
 			auto& self = *static_cast<derived*>(this);
 	
@@ -36,6 +48,22 @@ namespace augs {
 			);
 		}
 	
+		/* Measurements that only ever track their last sample keep doing so. */
+
+		void set_window_of_measurements(const std::size_t tracked_count) {
+			const auto window = std::clamp(
+				tracked_count, 
+				std::size_t(1), 
+				std::size_t(std::numeric_limits<unsigned short>::max())
+			);
+
+			for_each_measurement([window](const auto&, auto& m) { 
+				if (m.tracked.size() > 1) {
+					m.set_window(window); 
+				}
+			});
+		}
+
 		auto summary() const {
 			std::vector<const time_measurements*> all_with_time;
 			std::string times_summary;
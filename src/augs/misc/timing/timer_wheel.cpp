@@ -0,0 +1,74 @@
+#if BUILD_UNIT_TESTS
+#include <vector>
+#include <Catch/single_include/catch2/catch.hpp>
+#include "augs/misc/timing/timer_wheel.h"
+
+TEST_CASE("TimerWheel ScheduleThenAdvanceLater") {
+	augs::timer_wheel<int> wheel(0.001, 1000);
+	std::vector<int> fired;
+
+	const auto collect = [&](const int item) {
+		fired.push_back(item);
+	};
+
+	wheel.schedule(1, 100.010);
+	wheel.schedule(2, 100.020);
+	wheel.schedule(3, 100.500);
+
+	wheel.advance(100.005, collect);
+	REQUIRE(fired.empty());
+
+	wheel.advance(100.025, collect);
+	REQUIRE(fired == std::vector<int> { 1, 2 });
+	REQUIRE(wheel.size() == 1);
+
+	fired.clear();
+
+	wheel.advance(100.600, collect);
+	REQUIRE(fired == std::vector<int> { 3 });
+	REQUIRE(wheel.empty());
+}
+
+TEST_CASE("TimerWheel FirstAdvanceLongAfterSchedule") {
+	augs::timer_wheel<int> wheel(0.001, 1000);
+	std::vector<int> fired;
+
+	const auto collect = [&](const int item) {
+		fired.push_back(item);
+	};
+
+	wheel.schedule(1, 50.001);
+	wheel.schedule(2, 50.400);
+	wheel.schedule(3, 52.000);
+
+	/* More than a full revolution has passed since the first deadline. */
+	wheel.advance(51.500, collect);
+
+	REQUIRE(fired.size() == 2);
+	REQUIRE(wheel.size() == 1);
+
+	fired.clear();
+
+	wheel.advance(51.999, collect);
+	REQUIRE(fired.empty());
+
+	wheel.advance(52.000, collect);
+	REQUIRE(fired == std::vector<int> { 3 });
+}
+
+TEST_CASE("TimerWheel OverdueFiresOnNextAdvance") {
+	augs::timer_wheel<int> wheel(0.001, 1000);
+	std::vector<int> fired;
+
+	const auto collect = [&](const int item) {
+		fired.push_back(item);
+	};
+
+	wheel.advance(10.0, collect);
+	wheel.schedule(7, 9.0);
+
+	wheel.advance(10.001, collect);
+	REQUIRE(fired == std::vector<int> { 7 });
+	REQUIRE(wheel.empty());
+}
+#endif
@@ -0,0 +1,119 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace augs {
+	/*
+		Hashed timing wheel.
+		Deadlines are bucketed into slots of a fixed resolution,
+		so scheduling is O(1) and advancing only visits the slots that have elapsed.
+		Deadlines further away than one full revolution simply stay in their slot for more rounds.
+	*/
+
+	template <class T>
+	class timer_wheel {
+		struct entry {
+			double deadline;
+			T item;
+		};
+
+		std::vector<std::vector<entry>> slots;
+		std::vector<entry> postponed;
+
+		double resolution = 0.0;
+		long long current_tick = -1;
+		long long earliest_tick_before_start = std::numeric_limits<long long>::max();
+		std::size_t num_scheduled = 0;
+
+		long long to_tick(const double when) const {
+			return static_cast<long long>(std::floor(when / resolution));
+		}
+
+		auto& slot_of(const long long tick) {
+			return slots[static_cast<std::size_t>(tick % static_cast<long long>(slots.size()))];
+		}
+
+	public:
+		timer_wheel(
+			const double resolution_secs,
+			const std::size_t num_slots
+		) :
+			slots(num_slots),
+			resolution(resolution_secs)
+		{}
+
+		void schedule(const T& item, const double deadline) {
+			auto tick = to_tick(deadline);
+
+			if (tick <= current_tick) {
+				/* Already overdue - will fire on the next advance. */
+				tick = current_tick + 1;
+			}
+
+			if (current_tick == -1) {
+				earliest_tick_before_start = std::min(earliest_tick_before_start, tick);
+			}
+
+			slot_of(tick).push_back({ deadline, item });
+			++num_scheduled;
+		}
+
+		template <class F>
+		void advance(const double now, F&& callback) {
+			const auto target_tick = to_tick(now);
+
+			if (current_tick == -1) {
+				/* 
+					Nothing was visited yet,
+					so the first sweep must begin at the earliest deadline scheduled so far.
+				*/
+
+				current_tick = std::min(target_tick, earliest_tick_before_start) - 1;
+			}
+
+			const auto num_slots = static_cast<long long>(slots.size());
+			const auto first_tick = current_tick + 1;
+			const auto last_tick = std::min(target_tick, current_tick + num_slots);
+
+			for (auto tick = first_tick; tick <= last_tick; ++tick) {
+				auto& slot = slot_of(tick);
+
+				for (const auto& e : slot) {
+					if (e.deadline <= now) {
+						--num_scheduled;
+						callback(e.item);
+					}
+					else {
+						postponed.push_back(e);
+					}
+				}
+
+				slot.clear();
+			}
+
+			current_tick = target_tick;
+
+			for (const auto& e : postponed) {
+				--num_scheduled;
+				schedule(e.item, e.deadline);
+			}
+
+			postponed.clear();
+		}
+
+		double get_resolution() const {
+			return resolution;
+		}
+
+		bool empty() const {
+			return num_scheduled == 0;
+		}
+
+		std::size_t size() const {
+			return num_scheduled;
+		}
+	};
+}
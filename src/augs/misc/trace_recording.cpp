@@ -0,0 +1,127 @@
+#include <mutex>
+#include <chrono>
+#include <fstream>
+
+#include "augs/log.h"
+#include "augs/misc/trace_recording.h"
+#include "augs/string/typesafe_sprintf.h"
+
+namespace augs {
+	std::atomic<bool> trace_recording_enabled { false };
+
+	namespace {
+		using clock_type = std::chrono::steady_clock;
+
+		/* Flush to the disk in chunks so that a long-running server does not hoard the events in memory. */
+		constexpr std::size_t flush_threshold = 1 << 20;
+
+		struct trace_file {
+			std::mutex lk;
+			std::ofstream out;
+			std::string pending;
+			clock_type::time_point origin;
+			bool first_event = true;
+
+			void flush() {
+				out << pending;
+				out.flush();
+				pending.clear();
+			}
+		};
+
+		trace_file& get_trace_file() {
+			static trace_file f;
+			return f;
+		}
+
+		int current_thread_index() {
+			static std::atomic<int> next_index { 0 };
+			thread_local const int index = next_index++;
+
+			return index;
+		}
+
+		void append_escaped(std::string& into, const std::string& s) {
+			for (const auto c : s) {
+				if (c == '"' || c == '\\') {
+					into += '\\';
+				}
+
+				into += c;
+			}
+		}
+	}
+
+	void start_trace_recording(const path_type& target) {
+		auto& f = get_trace_file();
+		std::scoped_lock lock(f.lk);
+
+		if (trace_recording_enabled) {
+			return;
+		}
+
+		f.out.open(target, std::ios::out | std::ios::trunc);
+
+		if (!f.out) {
+			LOG("Failed to open %x for trace recording.", target);
+			return;
+		}
+
+		LOG("Recording the trace of all measured intervals to %x.", target);
+
+		f.out << "{\"traceEvents\":[\n";
+		f.origin = clock_type::now();
+		f.first_event = true;
+
+		trace_recording_enabled = true;
+	}
+
+	void stop_trace_recording() {
+		auto& f = get_trace_file();
+		std::scoped_lock lock(f.lk);
+
+		if (!trace_recording_enabled) {
+			return;
+		}
+
+		trace_recording_enabled = false;
+
+		f.pending += "\n]}\n";
+		f.flush();
+		f.out.close();
+	}
+
+	void record_trace_interval(const std::string& name, const double duration_secs) {
+		const auto now = clock_type::now();
+		const auto tid = current_thread_index();
+
+		auto& f = get_trace_file();
+		std::scoped_lock lock(f.lk);
+
+		if (!trace_recording_enabled) {
+			return;
+		}
+
+		const auto end_us = std::chrono::duration<double, std::micro>(now - f.origin).count();
+		const auto duration_us = duration_secs * 1000000;
+
+		if (!f.first_event) {
+			f.pending += ",\n";
+		}
+
+		f.first_event = false;
+
+		f.pending += "{\"name\":\"";
+		append_escaped(f.pending, name);
+		f.pending += typesafe_sprintf(
+			"\",\"ph\":\"X\",\"pid\":1,\"tid\":%x,\"ts\":%f3,\"dur\":%f3}",
+			tid,
+			end_us - duration_us,
+			duration_us
+		);
+
+		if (f.pending.size() >= flush_threshold) {
+			f.flush();
+		}
+	}
+}
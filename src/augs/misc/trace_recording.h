@@ -0,0 +1,22 @@
+#pragma once
+#include <atomic>
+#include <string>
+#include "augs/filesystem/path_declaration.h"
+
+namespace augs {
+	/*
+		Writes every interval measured by time_measurements to a file
+		in the Chrome trace event format, viewable in chrome://tracing or Perfetto.
+	*/
+
+	extern std::atomic<bool> trace_recording_enabled;
+
+	inline bool is_trace_recording() {
+		return trace_recording_enabled.load(std::memory_order_relaxed);
+	}
+
+	void start_trace_recording(const path_type& target);
+	void stop_trace_recording();
+
+	void record_trace_interval(const std::string& name, double duration_secs);
+}
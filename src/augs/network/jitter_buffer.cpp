@@ -0,0 +1,184 @@
+#if BUILD_UNIT_TESTS
+#include <cmath>
+#include <random>
+#include <vector>
+#include <Catch/single_include/catch2/catch.hpp>
+
+#include "augs/log.h"
+#include "augs/network/jitter_buffer.h"
+
+namespace {
+	struct replay_result {
+		unsigned underruns = 0;
+		double mean_added_latency = 0.0;
+		double max_added_latency = 0.0;
+	};
+
+	/*
+		Replays a trace of arrival times - one per command, in steps - as if it were received by a server
+		that unpacks the buffer once per step. Arrivals are quantized to the step in which they are handled.
+
+		The added latency of a command is the number of steps it spent waiting in the buffer.
+	*/
+
+	replay_result replay(const std::vector<double>& arrivals, const std::size_t lower_limit, const std::size_t upper_limit) {
+		augs::jitter_buffer<double> buffer;
+
+		buffer.set_lower_limit(lower_limit);
+		buffer.set_upper_limit(upper_limit);
+
+		replay_result result;
+
+		std::size_t next_arrival = 0;
+		std::size_t num_unpacked = 0;
+		double total_latency = 0.0;
+
+		for (std::size_t step = 0; num_unpacked < arrivals.size(); ++step) {
+			const auto now = static_cast<double>(step);
+
+			while (next_arrival < arrivals.size() && arrivals[next_arrival] <= now) {
+				buffer.acquire_new_command(arrivals[next_arrival], now);
+				++next_arrival;
+			}
+
+			const auto n = buffer.next_step();
+
+			for (std::size_t i = 0; i < n; ++i) {
+				const auto added_latency = now - std::ceil(buffer[i]);
+
+				total_latency += added_latency;
+				result.max_added_latency = std::max(result.max_added_latency, added_latency);
+			}
+
+			buffer.pop_front(n);
+			num_unpacked += n;
+		}
+
+		result.underruns = buffer.get_underruns();
+		result.mean_added_latency = total_latency / arrivals.size();
+
+		return result;
+	}
+
+	/* Commands sent once per step, delayed by the base latency plus the given extra delays, and received in order. */
+
+	template <class F>
+	std::vector<double> make_trace(const std::size_t n, const double base_latency, F&& extra_delay) {
+		std::vector<double> arrivals(n);
+
+		for (std::size_t i = 0; i < n; ++i) {
+			arrivals[i] = static_cast<double>(i) + base_latency + extra_delay(i);
+
+			if (i > 0) {
+				arrivals[i] = std::max(arrivals[i], arrivals[i - 1]);
+			}
+		}
+
+		return arrivals;
+	}
+
+	void report(const char* const trace, const char* const buffer, const replay_result& r) {
+		LOG(
+			"%x trace, %x buffer: %x underruns, added latency: %f2 steps on average, %f2 at most.",
+			trace,
+			buffer,
+			r.underruns,
+			r.mean_added_latency,
+			r.max_added_latency
+		);
+	}
+}
+
+TEST_CASE("JitterBuffer RingOrder") {
+	augs::jitter_buffer<int> buffer;
+
+	int next_expected = 0;
+	int next_pushed = 0;
+
+	/* Interleave so that the ring grows while it is wrapped around. */
+
+	for (int round = 0; round < 50; ++round) {
+		for (int i = 0; i < round % 7 + 2; ++i) {
+			buffer.acquire_new_command(next_pushed++, 0.0);
+		}
+
+		for (int i = 0; i < round % 5 + 1 && !buffer.empty(); ++i) {
+			REQUIRE(next_expected++ == buffer.front());
+			buffer.pop_front();
+		}
+	}
+
+	while (!buffer.empty()) {
+		REQUIRE(next_expected++ == buffer.front());
+		buffer.pop_front();
+	}
+
+	REQUIRE(next_expected == next_pushed);
+}
+
+TEST_CASE("JitterBuffer SyntheticTraces") {
+	const std::size_t num_commands = 6000;
+
+	SECTION("Steady arrivals need no buffering") {
+		const auto trace = make_trace(num_commands, 2.0, [](std::size_t) { return 0.0; });
+		const auto adaptive = replay(trace, 1, 16);
+
+		report("Steady", "adaptive", adaptive);
+
+		REQUIRE(0 == adaptive.underruns);
+		REQUIRE(adaptive.max_added_latency < 1.0);
+	}
+
+	SECTION("Jittery arrivals") {
+		std::minstd_rand rng(1234);
+		std::uniform_real_distribution<double> delay(0.0, 4.0);
+
+		const auto trace = make_trace(num_commands, 2.0, [&](std::size_t) { return delay(rng); });
+
+		const auto unbuffered = replay(trace, 1, 1);
+		const auto adaptive = replay(trace, 1, 16);
+
+		report("Jittery", "unbuffered", unbuffered);
+		report("Jittery", "adaptive", adaptive);
+
+		REQUIRE(adaptive.underruns * 4 < unbuffered.underruns);
+		REQUIRE(adaptive.mean_added_latency < 6.0);
+	}
+
+	SECTION("Bursty losses") {
+		/* Every half a second a few commands are lost and only come with the retransmission. */
+
+		const auto trace = make_trace(num_commands, 2.0, [](const std::size_t i) {
+			const auto phase = i % 30;
+			return phase < 4 ? static_cast<double>(4 - phase) : 0.0;
+		});
+
+		const auto unbuffered = replay(trace, 1, 1);
+		const auto fixed = replay(trace, 6, 6);
+		const auto adaptive = replay(trace, 1, 16);
+
+		report("Bursty", "unbuffered", unbuffered);
+		report("Bursty", "fixed", fixed);
+		report("Bursty", "adaptive", adaptive);
+
+		REQUIRE(adaptive.underruns < unbuffered.underruns);
+		REQUIRE(adaptive.mean_added_latency <= fixed.mean_added_latency);
+	}
+
+	SECTION("Clearing resets the statistics") {
+		augs::jitter_buffer<int> buffer;
+
+		for (int i = 0; i < 100; ++i) {
+			buffer.acquire_new_command(i, static_cast<double>(i % 2 ? i + 5 : i));
+		}
+
+		REQUIRE(buffer.get_target_depth() > 1);
+
+		buffer.clear();
+
+		REQUIRE(buffer.empty());
+		REQUIRE(1 == buffer.get_target_depth());
+		REQUIRE(0 == buffer.get_underruns());
+	}
+}
+#endif
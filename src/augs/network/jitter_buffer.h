@@ -1,82 +1,221 @@
 #pragma once
+#include <cmath>
 #include <vector>
+#include <cstddef>
+#include <utility>
+#include <algorithm>
+
+#include "augs/ensure.h"
 
 namespace augs {
-	template<class command>
+	/*
+		Smooths out the irregular arrival of commands that are produced at a steady rate - once per step.
+
+		The consumer calls next_step once per step to learn how many commands it should unpack.
+		After an underrun - a step for which no command was available - the buffer holds the commands back
+		until it fills up to its target depth again. The deeper the buffer, the more latency it adds,
+		but the fewer underruns happen.
+
+		The target depth adapts to the variance of the measured arrival times,
+		so that it stays shallow on a stable connection and grows on a jittery one.
+		If the buffer stays deeper than the target for a while, it is drained by unpacking an extra command.
+
+		Commands live in a ring buffer, so unpacking never moves the pending ones.
+		All times are expressed in steps.
+	*/
+
+	template <class command>
 	class jitter_buffer {
-		size_t lower_limit = 3;
-		unsigned steps_extrapolated = 0;
+		/* How many standard deviations of the arrival times should the target depth cover. */
+		static constexpr double deviations_covered = 2.0;
+
+		/*
+			The variance rises quickly and decays slowly,
+			so that the buffer stays prepared for bursts of late commands that repeat every now and then.
+		*/
+
+		static constexpr double mean_adaptation = 1.0 / 64;
+		static constexpr double variance_rise = 1.0 / 8;
+		static constexpr double variance_decay = 1.0 / 256;
+
+		/* For how many consecutive steps the buffer must be too deep before it is drained by a single command. */
+		static constexpr unsigned steps_to_drain = 8;
+
+		std::vector<command> ring;
+		std::size_t head = 0;
+		std::size_t count = 0;
+
+		std::size_t lower_limit = 1;
+		std::size_t upper_limit = 16;
 
 		bool initial_filling = true;
-	public:
-		std::vector<command> buffer;
-		
-		void acquire_new_command(const command& c) {
-			buffer.push_back(c);
+		bool started = false;
 
-			if (initial_filling) {
-				if (buffer.size() >= lower_limit) {
-					initial_filling = false;
-				}
+		unsigned steps_extrapolated = 0;
+		unsigned steps_above_target = 0;
+		unsigned underruns = 0;
+
+		std::size_t num_arrived = 0;
+		double mean_transit = 0.0;
+		double transit_variance = 0.0;
+
+		std::size_t wrap(const std::size_t i) const {
+			return i & (ring.size() - 1);
+		}
+
+		void grow() {
+			std::vector<command> new_ring(std::max(std::size_t(8), ring.size() * 2));
+
+			for (std::size_t i = 0; i < count; ++i) {
+				new_ring[i] = std::move(ring[wrap(head + i)]);
 			}
+
+			ring = std::move(new_ring);
+			head = 0;
 		}
 
-		void acquire_new_command(command&& c) {
-			buffer.emplace_back(c);
+		void note_arrival(const double arrival_step) {
+			/*
+				The n-th command was sent around the n-th step since the first one,
+				so once n is subtracted from its arrival time, only the transit time (plus a constant offset) remains.
+				The mean is tracked slowly so that a drift of the clocks is not mistaken for jitter.
+			*/
 
-			if (initial_filling) {
-				if (buffer.size() >= lower_limit) {
-					initial_filling = false;
-				}
+			const auto transit = arrival_step - static_cast<double>(num_arrived);
+
+			if (num_arrived++ == 0) {
+				mean_transit = transit;
+				return;
 			}
+
+			const auto deviation = transit - mean_transit;
+
+			const auto squared = deviation * deviation;
+
+			mean_transit += deviation * mean_adaptation;
+			transit_variance += (squared - transit_variance) * (squared > transit_variance ? variance_rise : variance_decay);
 		}
-		
+
+		void push(command&& c) {
+			if (count == ring.size()) {
+				grow();
+			}
+
+			ring[wrap(head + count)] = std::move(c);
+			++count;
+		}
+
+	public:
+		void acquire_new_command(const command& c, const double arrival_step) {
+			push(command(c));
+			note_arrival(arrival_step);
+		}
+
+		void acquire_new_command(command&& c, const double arrival_step) {
+			push(std::move(c));
+			note_arrival(arrival_step);
+		}
+
 		template <class Iter>
-		void acquire_new_commands(Iter first, Iter last) {
-			buffer.insert(buffer.end(), first, last);
+		void acquire_new_commands(Iter first, Iter last, const double arrival_step) {
+			for (; first != last; ++first) {
+				acquire_new_command(*first, arrival_step);
+			}
+		}
+
+		/* Call once per step. Returns the number of commands that should be unpacked for this step. */
 
+		std::size_t next_step() {
 			if (initial_filling) {
-				if (buffer.size() >= lower_limit) {
-					initial_filling = false;
+				if (count < get_target_depth()) {
+					if (started) {
+						++steps_extrapolated;
+					}
+
+					return 0;
 				}
+
+				initial_filling = false;
+				started = true;
 			}
-		}
 
-		std::vector<command> unpack_commands_once() {
-			std::vector<command> next_commands;
+			if (count == 0) {
+				++underruns;
+				++steps_extrapolated;
 
-			if (!initial_filling) {
-				const auto steps_to_unpack = steps_extrapolated + 1;
+				initial_filling = true;
+				steps_above_target = 0;
 
-				if (buffer.size() >= steps_to_unpack) {
-					next_commands.assign(buffer.begin(), buffer.begin() + steps_to_unpack);
-					buffer		  .erase(buffer.begin(), buffer.begin() + steps_to_unpack);
-				}
+				return 0;
+			}
 
-				const bool unpacked_successfully = next_commands.size() > 0;
+			steps_extrapolated = 0;
 
-				if (unpacked_successfully) {
-					steps_extrapolated = 0;
-				}
-				else {
-					++steps_extrapolated;
+			if (count > get_target_depth()) {
+				if (++steps_above_target >= steps_to_drain) {
+					steps_above_target = 0;
+					return 2;
 				}
 			}
+			else {
+				steps_above_target = 0;
+			}
 
-			return next_commands;
+			return 1;
 		}
 
-		bool unpack_next_command(command& next_command) {
-			if (!initial_filling) {
-				if (buffer.size() > 0) {
-					next_command = std::move(buffer.front());
-					buffer.erase(buffer.begin());
+		void pop_front(const std::size_t n = 1) {
+			ensure_leq(n, count);
 
-					return true;
-				}
+			for (std::size_t i = 0; i < n; ++i) {
+				ring[head] = command();
+				head = wrap(head + 1);
 			}
 
-			return false;
+			count -= n;
+		}
+
+		command& front() {
+			return (*this)[0];
+		}
+
+		const command& front() const {
+			return (*this)[0];
+		}
+
+		command& operator[](const std::size_t i) {
+			ensure_less(i, count);
+			return ring[wrap(head + i)];
+		}
+
+		const command& operator[](const std::size_t i) const {
+			ensure_less(i, count);
+			return ring[wrap(head + i)];
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+
+		bool empty() const {
+			return count == 0;
+		}
+
+		/* Keeps the allocated ring. */
+		void clear() {
+			pop_front(count);
+
+			head = 0;
+			initial_filling = true;
+			started = false;
+
+			steps_extrapolated = 0;
+			steps_above_target = 0;
+			underruns = 0;
+
+			num_arrived = 0;
+			mean_transit = 0.0;
+			transit_variance = 0.0;
 		}
 
 		void allow_to_refill() {
@@ -87,22 +226,38 @@ namespace augs {
 			return initial_filling;
 		}
 
-		size_t get_available_command_count() const {
-			return buffer.size();
+		/* The standard deviation of the arrival times, in steps. */
+		double get_arrival_jitter() const {
+			return std::sqrt(transit_variance);
+		}
+
+		std::size_t get_target_depth() const {
+			const auto wanted = 1 + static_cast<std::size_t>(std::ceil(deviations_covered * get_arrival_jitter()));
+			return std::clamp(wanted, lower_limit, std::max(lower_limit, upper_limit));
 		}
 
 		size_t get_lower_limit() const {
 			return lower_limit;
 		}
 
-		void set_lower_limit(size_t new_lower_limit) {
-			lower_limit = new_lower_limit;
+		void set_lower_limit(const size_t new_lower_limit) {
+			lower_limit = std::max(size_t(1), new_lower_limit);
+		}
+
+		size_t get_upper_limit() const {
+			return upper_limit;
+		}
+
+		void set_upper_limit(const size_t new_upper_limit) {
+			upper_limit = new_upper_limit;
 		}
 
 		unsigned get_steps_extrapolated() const {
 			return steps_extrapolated;
 		}
-	};
-
 
-}
\ No newline at end of file
+		unsigned get_underruns() const {
+			return underruns;
+		}
+	};
+}
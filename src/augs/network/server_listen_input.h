@@ -14,6 +14,15 @@ namespace augs {
 	struct dedicated_server_input {
 		// GEN INTROSPECTOR struct augs::dedicated_server_input
 		bool dummy = false;
+
+		/* Every next arena listens on the port following the previous one. */
+		unsigned num_arenas = 1;
+
+		/* 0 means one thread per hardware core. */
+		unsigned num_arena_threads = 0;
+
+		/* If set, every measured interval is written to this file as a Chrome trace. */
+		std::string trace_file_path;
 		// END GEN INTROSPECTOR
 	};
 }
@@ -298,6 +298,18 @@ namespace augs {
 			resize_no_init(storage, s);
 			detail::read_bytes_n(ar, storage.data(), s);
 		}
+		else if constexpr(is_paged_container_v<Container>) {
+			if constexpr(std::is_trivially_copyable_v<typename Container::value_type>) {
+				storage.resize_no_init(s);
+			}
+			else {
+				storage.resize(s);
+			}
+
+			storage.for_each_page([&ar](auto* const first, const std::size_t n) {
+				detail::read_bytes_n(ar, first, n);
+			});
+		}
 		else {
 			if constexpr(can_reserve_v<Container>) {
 				storage.reserve(s);
@@ -343,6 +355,11 @@ namespace augs {
 		if constexpr(can_access_data_v<Container>) {
 			detail::write_bytes_n(ar, storage.data(), s);
 		}
+		else if constexpr(is_paged_container_v<Container>) {
+			storage.for_each_page([&ar](const auto* const first, const std::size_t n) {
+				detail::write_bytes_n(ar, first, n);
+			});
+		}
 		else {
 			if constexpr(is_associative_v<Container>) {
 				for (auto&& it : storage) {
@@ -1,9 +1,14 @@
 #pragma once
 #include <vector>
+#include <limits>
+#include <utility>
+#include <algorithm>
 #include "augs/templates/traits/triviality_traits.h"
 #include "augs/templates/get_index_type_for_size_of.h"
 #include "augs/templates/introspect_declaration.h"
 #include "augs/readwrite/to_bytes.h"
+#include "augs/readwrite/byte_readwrite.h"
+#include "augs/readwrite/memory_stream.h"
 
 #include "augs/ensure.h"
 
@@ -253,4 +258,115 @@ namespace augs {
 		auto dt = object_delta<T>(in, read_changed_bit);
 		dt.decode_into(into);
 	}
+
+	/*
+		Delta between two byte buffers, e.g. two serialized states, which might differ in length.
+
+		Only the stretches of bytes that differ from the base are written, each preceded by
+		the number of unchanged bytes that come before it and by its own length.
+		Unchanged gaps too short to pay for a new stretch are written along with the changes.
+	*/
+
+	template <class A>
+	void write_bytes_delta(
+		const std::vector<std::byte>& base,
+		const std::vector<std::byte>& encoded,
+		A& out
+	) {
+		using offset_type = uint32_t;
+		constexpr std::size_t shortest_skipped_gap = sizeof(offset_type) * 2;
+
+		const auto encoded_size = encoded.size();
+		const auto common_size = std::min(base.size(), encoded_size);
+
+		/* Begin and end of each stretch. */
+		thread_local std::vector<std::pair<std::size_t, std::size_t>> stretches;
+		stretches.clear();
+
+		auto add_stretch = [&](const std::size_t begin, const std::size_t end) {
+			if (!stretches.empty() && begin - stretches.back().second < shortest_skipped_gap) {
+				stretches.back().second = end;
+			}
+			else {
+				stretches.emplace_back(begin, end);
+			}
+		};
+
+		for (std::size_t i = 0; i < common_size; ++i) {
+			if (base[i] != encoded[i]) {
+				add_stretch(i, i + 1);
+			}
+		}
+
+		if (encoded_size > common_size) {
+			add_stretch(common_size, encoded_size);
+		}
+
+		ensure_leq(encoded_size, std::numeric_limits<offset_type>::max());
+
+		augs::write_bytes(out, static_cast<offset_type>(encoded_size));
+		augs::write_bytes(out, static_cast<offset_type>(stretches.size()));
+
+		std::size_t previous_end = 0;
+
+		for (const auto& s : stretches) {
+			augs::write_bytes(out, static_cast<offset_type>(s.first - previous_end));
+			augs::write_bytes(out, static_cast<offset_type>(s.second - s.first));
+
+			detail::write_raw_bytes(out, encoded.data() + s.first, s.second - s.first);
+
+			previous_end = s.second;
+		}
+	}
+
+	template <class A>
+	void read_bytes_delta(
+		const std::vector<std::byte>& base,
+		A& in,
+		std::vector<std::byte>& decoded,
+		const std::size_t max_decoded_size = std::numeric_limits<std::size_t>::max()
+	) {
+		using offset_type = uint32_t;
+
+		offset_type encoded_size = 0;
+		offset_type num_stretches = 0;
+
+		augs::read_bytes(in, encoded_size);
+		augs::read_bytes(in, num_stretches);
+
+		if (encoded_size > max_decoded_size) {
+			throw stream_read_error(
+				"Decoded size (%x) exceeds the maximum of %x",
+				encoded_size,
+				max_decoded_size
+			);
+		}
+
+		decoded.assign(base.begin(), base.begin() + std::min(base.size(), std::size_t(encoded_size)));
+		decoded.resize(encoded_size);
+
+		std::size_t pos = 0;
+
+		for (offset_type i = 0; i < num_stretches; ++i) {
+			offset_type skipped = 0;
+			offset_type length = 0;
+
+			augs::read_bytes(in, skipped);
+			augs::read_bytes(in, length);
+
+			pos += skipped;
+
+			if (pos + length > decoded.size()) {
+				throw stream_read_error(
+					"Delta stretch %x-%x is out of bounds (size: %x)",
+					pos,
+					pos + length,
+					decoded.size()
+				);
+			}
+
+			detail::read_raw_bytes(in, decoded.data() + pos, length);
+			pos += length;
+		}
+	}
 }
\ No newline at end of file
@@ -215,6 +215,21 @@ namespace augs {
 		}
 	};
 
+	/* A non-owning view of bytes that live elsewhere, e.g. in a mapped file. Only for reading. */
+
+	struct byte_span {
+		const std::byte* first = nullptr;
+		std::size_t count = 0;
+
+		const std::byte* data() const {
+			return first;
+		}
+
+		std::size_t size() const {
+			return count;
+		}
+	};
+
 	template <class B>
 	class basic_ref_memory_stream : public memory_stream_mixin<basic_ref_memory_stream<B>> {
 		using base = memory_stream_mixin<basic_ref_memory_stream<B>>;
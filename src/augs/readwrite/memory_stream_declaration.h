@@ -12,8 +12,11 @@ namespace augs {
 	template <class B>
 	class basic_memory_stream;
 
+	struct byte_span;
+
 	using memory_stream = basic_memory_stream<std::vector<std::byte>>;
 
 	using ref_memory_stream = basic_ref_memory_stream<std::vector<std::byte>>;
 	using cref_memory_stream = basic_ref_memory_stream<const std::vector<std::byte>>;
+	using span_memory_stream = basic_ref_memory_stream<const byte_span>;
 }
@@ -1,4 +1,5 @@
 #if BUILD_UNIT_TESTS
+#include <cstddef>
 #include <Catch/single_include/catch2/catch.hpp>
 #include "augs/misc/pool/pool_io.hpp"
 #include "augs/misc/pool/pool.h"
@@ -8,6 +9,8 @@
 
 #include "augs/string/string_templates.h"
 #include "augs/readwrite/readwrite_test_cycle.h"
+#include "augs/readwrite/delta_compression.h"
+#include "augs/readwrite/write_bytes_field_by_field.h"
 
 #include "augs/math/vec2.h"
 #include "augs/math/transform.h"
@@ -403,4 +406,127 @@ TEST_CASE("Byte readwrite Variants and optionals") {
 		readwrite_test_cycle(v);
 	}
 }
+
+TEST_CASE("Byte readwrite BytesDelta") {
+	auto make_bytes = [](const std::size_t n) {
+		std::vector<std::byte> bytes(n);
+
+		for (std::size_t i = 0; i < n; ++i) {
+			bytes[i] = static_cast<std::byte>(i * 7 % 251);
+		}
+
+		return bytes;
+	};
+
+	const auto base = make_bytes(10000);
+
+	auto cycle = [&](const std::vector<std::byte>& encoded) {
+		augs::memory_stream s;
+		augs::write_bytes_delta(base, encoded, s);
+
+		std::vector<std::byte> decoded;
+		augs::read_bytes_delta(base, s, decoded);
+
+		REQUIRE(decoded == encoded);
+		return s.size();
+	};
+
+	SECTION("Unchanged") {
+		REQUIRE(cycle(base) < 16);
+	}
+
+	SECTION("Scattered changes") {
+		auto encoded = base;
+
+		encoded[0] = std::byte(1);
+		encoded[1] = std::byte(2);
+		encoded[5000] = std::byte(3);
+		encoded[5003] = std::byte(4);
+		encoded[9999] = std::byte(5);
+
+		REQUIRE(cycle(encoded) < 64);
+	}
+
+	SECTION("Shrunk and grown") {
+		auto shrunk = base;
+		shrunk.resize(4000);
+		cycle(shrunk);
+
+		auto grown = base;
+		grown[10] = std::byte(0);
+		grown.resize(12000, std::byte(9));
+		REQUIRE(cycle(grown) < 2100);
+	}
+
+	SECTION("Out of bounds stretches are rejected") {
+		augs::memory_stream s;
+		augs::write_bytes(s, uint32_t(100));
+		augs::write_bytes(s, uint32_t(1));
+		augs::write_bytes(s, uint32_t(99));
+		augs::write_bytes(s, uint32_t(2));
+		augs::write_bytes(s, uint16_t(0));
+
+		std::vector<std::byte> decoded;
+		REQUIRE_THROWS_AS(augs::read_bytes_delta(base, s, decoded), augs::stream_read_error);
+	}
+}
+
+struct field_by_field_dummy {
+	// GEN INTROSPECTOR struct field_by_field_dummy
+	char a = 'a';
+	int b = 2;
+	augs::constant_size_vector<int, 8> c;
+	// END GEN INTROSPECTOR
+};
+
+TEST_CASE("Byte readwrite FieldByField") {
+	auto make_dummy = [](const std::byte garbage) {
+		field_by_field_dummy d;
+
+		auto* const bytes = reinterpret_cast<std::byte*>(&d);
+
+		for (std::size_t i = sizeof(d.a); i < offsetof(field_by_field_dummy, b); ++i) {
+			bytes[i] = garbage;
+		}
+
+		d.c.push_back(1);
+		d.c.push_back(2);
+		d.c.push_back(static_cast<int>(garbage));
+		d.c.resize_no_init(2);
+
+		return d;
+	};
+
+	auto as_vector = [](const augs::memory_stream& s) {
+		return std::vector<std::byte>(s.data(), s.data() + s.get_write_pos());
+	};
+
+	auto whole_bytes = [&](const auto& object) {
+		augs::memory_stream s;
+		augs::write_bytes(s, object);
+
+		return as_vector(s);
+	};
+
+	auto field_by_field_bytes = [&](const auto& object) {
+		augs::memory_stream s;
+		augs::write_bytes_field_by_field(s, object);
+
+		return as_vector(s);
+	};
+
+	const auto first = make_dummy(std::byte(0x11));
+	auto second = make_dummy(std::byte(0x22));
+
+	/* Padding and the unused storage of c differ, which write_bytes does not skip */
+	REQUIRE(whole_bytes(first) != whole_bytes(second));
+	REQUIRE(field_by_field_bytes(first) == field_by_field_bytes(second));
+
+	second.c.push_back(3);
+	REQUIRE(field_by_field_bytes(first) != field_by_field_bytes(second));
+
+	second.c.pop_back();
+	second.b = 3;
+	REQUIRE(field_by_field_bytes(first) != field_by_field_bytes(second));
+}
 #endif
\ No newline at end of file
@@ -0,0 +1,103 @@
+#pragma once
+#include <cstdint>
+#include <tuple>
+
+#include "augs/pad_bytes.h"
+#include "augs/templates/introspect.h"
+#include "augs/templates/traits/is_pair.h"
+#include "augs/templates/traits/is_tuple.h"
+#include "augs/templates/traits/is_variant.h"
+#include "augs/templates/traits/is_monostate.h"
+#include "augs/templates/traits/is_optional.h"
+#include "augs/templates/traits/is_unique_ptr.h"
+#include "augs/templates/traits/is_std_array.h"
+#include "augs/templates/traits/container_traits.h"
+#include "augs/misc/enum/is_enum_boolset.h"
+#include "augs/readwrite/byte_readwrite.h"
+
+namespace augs {
+	/*
+		Unlike write_bytes, which dumps every trivially copyable object whole,
+		this descends into the introspected fields of all objects and writes each leaf separately.
+
+		Padding and unused storage (e.g. past the size of a constant_size_vector) are never written,
+		so objects that compare equal always produce the same bytes.
+		Meant for hashing - the output is not supposed to be read back.
+	*/
+
+	template <class Archive, class Serialized>
+	void write_bytes_field_by_field(Archive& ar, const Serialized& storage) {
+		using T = remove_cref<Serialized>;
+
+		if constexpr(std::is_arithmetic_v<T> || std::is_enum_v<T> || is_enum_boolset_v<T>) {
+			write_bytes(ar, storage);
+		}
+		else if constexpr(is_optional_v<T> || is_unique_ptr_v<T>) {
+			const bool has_value = static_cast<bool>(storage);
+			write_bytes(ar, has_value);
+
+			if (has_value) {
+				write_bytes_field_by_field(ar, *storage);
+			}
+		}
+		else if constexpr(is_variant_v<T>) {
+			write_bytes(ar, static_cast<unsigned>(storage.index()));
+
+			if (!storage.valueless_by_exception()) {
+				std::visit(
+					[&](const auto& object) {
+						if constexpr(!is_monostate_v<decltype(object)>) {
+							write_bytes_field_by_field(ar, object);
+						}
+					},
+					storage
+				);
+			}
+		}
+		else if constexpr(is_pair_v<T>) {
+			write_bytes_field_by_field(ar, storage.first);
+			write_bytes_field_by_field(ar, storage.second);
+		}
+		else if constexpr(is_tuple_v<T>) {
+			std::apply(
+				[&](const auto&... elements) {
+					(write_bytes_field_by_field(ar, elements), ...);
+				},
+				storage
+			);
+		}
+		else if constexpr(is_std_array_v<T> || is_enum_array_v<T>) {
+			for (const auto& element : storage) {
+				write_bytes_field_by_field(ar, element);
+			}
+		}
+		else if constexpr(is_container_v<T>) {
+			write_bytes(ar, static_cast<uint32_t>(storage.size()));
+
+			using V = remove_cref<decltype(*storage.begin())>;
+
+			if constexpr(can_access_data_v<T> && (std::is_arithmetic_v<V> || std::is_enum_v<V>)) {
+				detail::write_raw_bytes(ar, storage.data(), storage.size());
+			}
+			else {
+				for (const auto& element : storage) {
+					write_bytes_field_by_field(ar, element);
+				}
+			}
+		}
+		else if constexpr(has_introspect_v<T>) {
+			introspect(
+				[&](auto, const auto& member) {
+					if constexpr(!is_padding_field_v<remove_cref<decltype(member)>>) {
+						write_bytes_field_by_field(ar, member);
+					}
+				},
+				storage
+			);
+		}
+		else {
+			/* No introspector, e.g. a type with its own i/o overloads. */
+			write_bytes(ar, storage);
+		}
+	}
+}
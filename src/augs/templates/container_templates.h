@@ -55,7 +55,7 @@ template <class Container, class T>
 auto erase_element(Container& v, const T& l) {
 	static_assert(!std::is_same_v<decltype(v.begin()), T>, "erase_element serves to erase keys or values, not iterators!");
 
-	if constexpr(can_access_data_v<Container>) {
+	if constexpr(can_access_data_v<Container> || is_paged_container_v<Container>) {
 		v.erase(std::remove(v.begin(), v.end(), l), v.end());
 	}
 	else {
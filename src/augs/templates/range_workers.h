@@ -1,6 +1,7 @@
 #pragma once
 #include <vector>
 #include <thread>
+#include <optional>
 #include <atomic>
 #include <mutex>
 #include <condition_variable>
@@ -13,7 +14,14 @@ namespace augs {
 		using element_type = std::remove_reference_t<argument_t<Callback, 0>>;
 		using Item = element_type*;
 
+		/* 
+			Guarded by the mutex.
+			A worker joins a batch only while count is nonzero,
+			and copies it under the lock, so clearing it can never make a worker drop an index it has already taken.
+		*/
+
 		int count = 0;
+		unsigned generation = 0;
 		element_type* arr = nullptr;
 
 		std::optional<Callback> callback;
@@ -28,17 +36,31 @@ namespace augs {
 
 		auto make_worker_function() {
 			return [&]() {
+				unsigned joined_generation = 0;
+
 				while (true) {
+					int joined_count = 0;
+
 					{
 						std::unique_lock<std::mutex> lk(m);
-						cv.wait(lk, [this]{ return shall_quit || count; });
-					}
 
-					if (shall_quit.load()) {
-						return;
+						cv.wait(lk, [&]{ 
+							return shall_quit || (count && generation != joined_generation); 
+						});
+
+						if (shall_quit.load()) {
+							return;
+						}
+
+						joined_generation = generation;
+						joined_count = count;
+
+						num_busy_workers.fetch_add(1);
 					}
 
-					process_tasks();
+					process_tasks(joined_count);
+
+					num_busy_workers.fetch_sub(1);
 				}
 			};
 		}
@@ -59,20 +81,43 @@ namespace augs {
 		}
 
 		void quit_workers() {
-			shall_quit.store(true);
+			{
+				std::unique_lock<std::mutex> lk(m);
+				shall_quit.store(true);
+			}
+
 			cv.notify_all();
 			join_all();
 			workers.clear();
 		}
 
-		void wait_complete() {
-			process_tasks();
+		void wait_complete(const int n) {
+			process_tasks(n);
+
+			{
+				/* No worker can join after this, so the busy ones are all that is left to wait for. */
+				std::unique_lock<std::mutex> lk(m);
+				count = 0;
+			}
 
 			while (num_busy_workers.load()) {
 				std::this_thread::yield();
 			}
 		}
 
+		void process_tasks(const int n) {
+			while (true) {
+				const auto i = it.fetch_add(1, std::memory_order_relaxed);
+
+				if (i < n) {
+					(*callback)(arr[i]);
+				}
+				else {
+					break;
+				}
+			}
+		}
+
 	public:
 		range_workers(const std::size_t n) {
 			init_workers(n);
@@ -86,23 +131,6 @@ namespace augs {
 		range_workers(range_workers&&) = delete;
 		range_workers& operator=(range_workers&&) = delete;
 
-		auto process_tasks() {
-			num_busy_workers.fetch_add(1);
-
-			while (true) {
-				const auto i = it.fetch_add(1, std::memory_order_relaxed);
-
-				if (i < count) {
-					(*callback)(arr[i]);
-				}
-				else {
-					break;
-				}
-			}
-
-			num_busy_workers.fetch_sub(1);
-		}
-
 		void resize_workers(const std::size_t num) {
 			if (num == workers.size()) {
 				return;
@@ -114,20 +142,25 @@ namespace augs {
 
 		template <class C, class R>
 		void process(C&& call, R& range) {
+			const auto n = static_cast<int>(range.size());
+
+			if (n == 0) {
+				return;
+			}
+
 			{
 				std::unique_lock<std::mutex> lk(m);
 
-				it = 0;
-				count = range.size();
 				arr = range.data();
-
 				callback.emplace(std::forward<C>(call));
+
+				it = 0;
+				count = n;
+				++generation;
 			}
 
 			cv.notify_all();
-			wait_complete();
-
-			count = 0;
+			wait_complete(n);
 		}
 
 		~range_workers() {
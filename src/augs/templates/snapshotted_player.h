@@ -1,10 +1,13 @@
 #pragma once
 #include <map>
+#include <vector>
+#include <optional>
 #include "augs/misc/timing/stepped_timing.h"
 #include "augs/misc/timing/fixed_delta_timer.h"
 #include "augs/misc/timing/delta.h"
 #include "augs/templates/snapshotted_player_step_type.h"
 #include "augs/templates/snapshotted_player_settings.h"
+#include "augs/misc/packed_snapshot.h"
 
 namespace augs {
 	struct introspection_access;
@@ -34,6 +37,11 @@ namespace augs {
 		class snapshot_type
 	>
 	class snapshotted_player {
+		static_assert(
+			std::is_same_v<snapshot_type, std::vector<std::byte>>,
+			"Snapshots are packed as deltas of bytes."
+		);
+
 	public: 
 		using step_type = snapshotted_player_step_type;
 		using step_to_entropy_type = std::map<step_type, entropy_type>;
@@ -47,7 +55,7 @@ namespace augs {
 		};
 
 		friend introspection_access;
-		using snapshots_type = std::map<step_type, snapshot_type>;
+		using snapshots_type = std::map<step_type, packed_snapshot>;
 
 		// GEN INTROSPECTOR class augs::snapshotted_player class A class B
 		step_to_entropy_type step_to_entropy;
@@ -62,8 +70,18 @@ namespace augs {
 		step_type additional_steps = 0;
 		// END GEN INTROSPECTOR
 
+		/* The unpacked bytes of the newest snapshot, which the next delta is made against. */
+		snapshot_type last_pushed;
+		std::optional<step_type> last_pushed_step;
+
+		double last_seek_secs = 0.0;
+
 		template <class GenerateSnapshot>
-		void push_snapshot_if_needed(GenerateSnapshot&&, unsigned interval_in_steps);
+		void push_snapshot_if_needed(GenerateSnapshot&&, const snapshotted_player_settings&);
+
+		void push_snapshot(step_type, snapshot_type&&, const snapshotted_player_settings&);
+		void thin_snapshots_to_budget(std::size_t budget_bytes);
+		void unpack_snapshot_at(typename snapshots_type::const_iterator, snapshot_type& output) const;
 
 		template <class I>
 		void advance_single_step(const I& input);
@@ -101,6 +119,8 @@ namespace augs {
 
 		const fixed_delta_timer& get_timer() const;
 		const snapshots_type& get_snapshots() const;
+		std::size_t get_snapshots_memory() const;
+		double get_last_seek_secs() const;
 
 		void pause();
 		void resume();
@@ -1,6 +1,7 @@
 #pragma once
 #include "augs/templates/snapshotted_player.h"
 #include "augs/readwrite/byte_file.h"
+#include "augs/misc/timing/timer.h"
 
 #define LOG_PLAYER 1
 
@@ -73,6 +74,22 @@ namespace augs {
 		return snapshots;
 	}
 
+	template <class A, class B>
+	std::size_t snapshotted_player<A, B>::get_snapshots_memory() const {
+		std::size_t total = 0;
+
+		for (const auto& s : snapshots) {
+			total += s.second.compressed.size();
+		}
+
+		return total;
+	}
+
+	template <class A, class B>
+	double snapshotted_player<A, B>::get_last_seek_secs() const {
+		return last_seek_secs;
+	}
+
 	template <class A, class B>
    	void snapshotted_player<A, B>::finish() {
 		step_to_entropy.clear();
@@ -80,6 +97,9 @@ namespace augs {
 		additional_steps = 0;
 		snapshots.clear();
 
+		last_pushed.clear();
+		last_pushed_step = std::nullopt;
+
 		pause();
 	}
 
@@ -137,13 +157,18 @@ namespace augs {
 
 		PLR_LOG("Seeking from %x to %x", current_step, seeked_step);
 
-		const auto& seeked_adj_snapshot = *std::prev(snapshots.upper_bound(seeked_step)); 
-		const auto step_of_adj_snapshot = seeked_adj_snapshot.first;
+		augs::timer seek_timer;
+
+		const auto seeked_adj_snapshot = std::prev(snapshots.upper_bound(seeked_step)); 
+		const auto step_of_adj_snapshot = seeked_adj_snapshot->first;
 	   
 		auto seek_to_snapshot = [&]() {
 			PLR_LOG("Set snapshot at step %x (size: %x)", current_step, snapshots.size());
 
-			load_snapshot(step_of_adj_snapshot, seeked_adj_snapshot.second);
+			thread_local snapshot_type unpacked;
+			unpack_snapshot_at(seeked_adj_snapshot, unpacked);
+
+			load_snapshot(step_of_adj_snapshot, unpacked);
 
 			current_step = step_of_adj_snapshot;
 		};
@@ -178,11 +203,125 @@ namespace augs {
 		while (current_step < seeked_step) {
 			advance_single_step(input);
 		}
+
+		last_seek_secs = seek_timer.get<std::chrono::seconds>();
+	}
+
+	template <class A, class snapshot_type>
+	void snapshotted_player<A, snapshot_type>::unpack_snapshot_at(
+		const typename snapshots_type::const_iterator it,
+		snapshot_type& output
+	) const {
+		/* Deltas are chained, so start from the nearest keyframe. */
+
+		auto keyframe = it;
+
+		while (!keyframe->second.keyframe) {
+			ensure(keyframe != snapshots.begin());
+			--keyframe;
+		}
+
+		for (auto s = keyframe; ; ++s) {
+			augs::unpack_snapshot(s->second, output);
+
+			if (s == it) {
+				break;
+			}
+		}
+	}
+
+	template <class A, class snapshot_type>
+	void snapshotted_player<A, snapshot_type>::push_snapshot(
+		const step_type step,
+		snapshot_type&& bytes,
+		const snapshotted_player_settings& settings
+	) {
+		snapshots.erase(snapshots.lower_bound(step), snapshots.end());
+
+		const auto deltas_since_keyframe = [&]() {
+			unsigned n = 0;
+
+			for (auto it = snapshots.rbegin(); it != snapshots.rend() && !it->second.keyframe; ++it) {
+				++n;
+			}
+
+			return n;
+		}();
+
+		const bool can_make_delta = 
+			last_pushed_step.has_value()
+			&& !snapshots.empty()
+			&& snapshots.rbegin()->first == *last_pushed_step
+			&& deltas_since_keyframe + 1 < settings.snapshot_keyframe_interval
+		;
+
+		if (can_make_delta) {
+			snapshots[step] = augs::pack_delta(bytes, last_pushed);
+		}
+		else {
+			snapshots[step] = augs::pack_keyframe(bytes);
+		}
+
+		last_pushed = std::move(bytes);
+		last_pushed_step = step;
+
+		thin_snapshots_to_budget(static_cast<std::size_t>(settings.snapshot_memory_budget_mb) * 1024 * 1024);
+	}
+
+	template <class A, class B>
+	void snapshotted_player<A, B>::thin_snapshots_to_budget(const std::size_t budget_bytes) {
+		/*
+			First drop the last deltas of the oldest groups, which leaves the chains of all other deltas intact.
+			Once only keyframes are left, drop the oldest of them.
+
+			The very first and the newest snapshots are always kept,
+			so that every step stays reachable - at worst by simulating from the start.
+		*/
+
+		auto total = get_snapshots_memory();
+
+		auto erase = [&](const auto it) {
+			PLR_LOG("Thinning out the snapshot at step %x.", it->first);
+
+			total -= it->second.compressed.size();
+			snapshots.erase(it);
+		};
+
+		while (total > budget_bytes && snapshots.size() > 2) {
+			const auto newest = std::prev(snapshots.end());
+
+			auto last_delta_of_group = snapshots.end();
+
+			for (auto it = std::next(snapshots.begin()); it != newest; ++it) {
+				const auto next = std::next(it);
+
+				if (!it->second.keyframe && next->second.keyframe) {
+					last_delta_of_group = it;
+					break;
+				}
+			}
+
+			if (last_delta_of_group != snapshots.end()) {
+				erase(last_delta_of_group);
+				continue;
+			}
+
+			const auto oldest_keyframe = std::next(snapshots.begin());
+
+			if (oldest_keyframe->second.keyframe && std::next(oldest_keyframe)->second.keyframe) {
+				erase(oldest_keyframe);
+				continue;
+			}
+
+			break;
+		}
 	}
 
 	template <class A, class B>
 	template <class GenerateSnapshot>
-	void snapshotted_player<A, B>::push_snapshot_if_needed(GenerateSnapshot&& generate_snapshot, const unsigned interval_in_steps) {
+	void snapshotted_player<A, B>::push_snapshot_if_needed(GenerateSnapshot&& generate_snapshot, const snapshotted_player_settings& settings) {
+		const auto interval_in_steps = settings.snapshot_interval_in_steps;
+
 		if (is_recording() || (is_replaying() && get_current_step() == 0)) {
 			const bool is_snapshot_time = [&]() {
 				if (snapshots.empty()) {
@@ -202,7 +341,7 @@ namespace augs {
 
 			if (is_snapshot_time) {
 				PLR_LOG("Snapshot step: %x. Pushed.", current_step);
-				snapshots[current_step] = generate_snapshot(current_step);
+				push_snapshot(current_step, generate_snapshot(current_step), settings);
 			}
 		}
 		else {
@@ -219,7 +358,7 @@ namespace augs {
 	template <class entropy_type, class B>
 	template <class I>
 	void snapshotted_player<entropy_type, B>::advance_single_step(const I& in) {
-		push_snapshot_if_needed(in.generate_snapshot, in.settings.snapshot_interval_in_steps);
+		push_snapshot_if_needed(in.generate_snapshot, in.settings);
 
 		auto considered_mode = advance_mode;
 
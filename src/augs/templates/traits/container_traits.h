@@ -122,9 +122,19 @@ template <class A, class B>
 struct has_suitable_member_assign<A, B, decltype(std::declval<A&>().assign(std::declval<B&>().begin(), std::declval<B&>().end()), void())> : std::true_type {};
 
 
+template <class T, class = void>
+struct is_paged_container : std::false_type {};
+
+template <class T>
+struct is_paged_container<T, std::void_t<typename T::page_type>> : std::true_type {};
+
+
 template <class T>
 constexpr bool can_access_data_v = can_access_data<T>::value;
 
+template <class T>
+constexpr bool is_paged_container_v = is_paged_container<T>::value;
+
 template <class T>
 constexpr bool can_access_size_v = can_access_size<T>::value;
 
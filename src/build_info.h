@@ -15,9 +15,11 @@
 inline auto static_allocations_info() {
 	return typesafe_sprintf(
 		"STATICALLY_ALLOCATE_ENTITIES=%x\n"
-		"STATICALLY_ALLOCATE_ENTITY_FLAVOURS=%x\n",
+		"STATICALLY_ALLOCATE_ENTITY_FLAVOURS=%x\n"
+		"PAGED_ENTITY_POOLS=%x\n",
 		STATICALLY_ALLOCATE_ENTITIES,
-		STATICALLY_ALLOCATE_ENTITY_FLAVOURS
+		STATICALLY_ALLOCATE_ENTITY_FLAVOURS,
+		PAGED_ENTITY_POOLS
 	);
 }
 
@@ -80,6 +82,8 @@ Options:
                                 Contrary to the --dedicated-server option, this lets you play on your own server within the same game instance.
     --dedicated-server          The same as --server, but applies some settings suitable for a dedicated server instance.
                                 For example - the game will be started without a window.
+    --headless-benchmark        Advance an arena without a window or audio in accordance with headless_benchmark inside the config file.
+                                Per-system timings, raycast counts and the final state hash are written as JSON.
 
 If editor_file_path is supplied and it is a directory,
 the game will automatically launch the editor to try and open the project inside it, if there is one. 
@@ -9,6 +9,7 @@ struct cmd_line_params {
 	bool help_only = false;
 	bool start_server = false;
 	bool start_dedicated_server = false;
+	bool headless_benchmark = false;
 	bool should_connect = false;
 	std::string connect_to_address;
 
@@ -30,6 +31,9 @@ struct cmd_line_params {
 			else if (a == "--dedicated-server") {
 				start_dedicated_server = true;
 			}
+			else if (a == "--headless-benchmark") {
+				headless_benchmark = true;
+			}
 			else if (a == "--connect") {
 				should_connect = true;
 				
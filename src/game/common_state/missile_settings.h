@@ -0,0 +1,15 @@
+#pragma once
+#include "augs/pad_bytes.h"
+
+struct missile_settings {
+	// GEN INTROSPECTOR struct missile_settings
+	/*
+		Missiles get no bodies of their own and are advanced by rays swept against the physics world.
+		Cheaper when a lot of them are in flight,
+		but they stop colliding with each other and no longer push what they hit.
+	*/
+
+	bool swept_rays = false;
+	pad_bytes<3> pad;
+	// END GEN INTROSPECTOR
+};
@@ -138,9 +138,18 @@ float component_synchronizer<E, components::rigid_body>::get_degrees() const {
 	return get_radians() * RAD_TO_DEG<float>;
 }
 
+/*
+	Getters of the transform and velocities fall back to the component when there is no body,
+	e.g. for missiles advanced by swept rays.
+*/
+
 template <class E>
 float component_synchronizer<E, components::rigid_body>::get_radians() const {
-	return body().GetAngle();
+	if (const auto body = find_body()) {
+		return body->GetAngle();
+	}
+
+	return get_raw_component().physics_transforms.m_sweep.a;
 }
 
 template <class E>
@@ -150,7 +159,11 @@ float component_synchronizer<E, components::rigid_body>::get_degree_velocity() c
 
 template <class E>
 float component_synchronizer<E, components::rigid_body>::get_radian_velocity() const {
-	return body().GetAngularVelocity();
+	if (const auto body = find_body()) {
+		return body->GetAngularVelocity();
+	}
+
+	return get_raw_component().angular_velocity;
 }
 
 template <class E>
@@ -160,7 +173,11 @@ float component_synchronizer<E, components::rigid_body>::get_inertia() const {
 
 template <class E>
 vec2 component_synchronizer<E, components::rigid_body>::get_position() const {
-	return to_pixels(body().GetPosition());
+	if (const auto body = find_body()) {
+		return to_pixels(body->GetPosition());
+	}
+
+	return to_pixels(get_raw_component().physics_transforms.m_xf.p);
 }
 
 template <class E>
@@ -175,7 +192,11 @@ vec2 component_synchronizer<E, components::rigid_body>::get_mass_position() cons
 
 template <class E>
 vec2 component_synchronizer<E, components::rigid_body>::get_velocity() const {
-	return to_pixels(body().GetLinearVelocity());
+	if (const auto body = find_body()) {
+		return to_pixels(body->GetLinearVelocity());
+	}
+
+	return to_pixels(get_raw_component().velocity);
 }
 
 template <class E>
@@ -14,5 +14,10 @@ void cosmic::change_solvable_significant(C& cosm, F&& callback) {
 		}
 	});
 
-	status = callback(cosm.get_solvable({}).significant);
+	auto& significant = cosm.get_solvable({}).significant;
+
+	/* The callback might replace anything. */
+	significant.pool_stamps.mark_all();
+
+	status = callback(significant);
 }
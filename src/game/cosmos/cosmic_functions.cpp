@@ -14,6 +14,7 @@
 #include "game/inferred_caches/processing_lists_cache.hpp"
 #include "game/inferred_caches/flavour_id_cache.hpp"
 #include "game/inferred_caches/physics_world_cache.hpp"
+#include "game/inferred_caches/navigation_cache.hpp"
 
 entity_handle just_create_entity(
 	cosmos& cosm,
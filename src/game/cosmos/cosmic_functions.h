@@ -21,7 +21,7 @@ enum class reinference_type {
 };
 
 template <class E>
-struct entity_solvable;
+struct entity_content;
 
 class cosmic {
 	static void destroy_caches_of(const entity_handle& h);
@@ -38,6 +38,9 @@ class cosmic {
 		P pre_construction
 	);
 
+	template <class handle_type, class I>
+	static void assign_components(handle_type handle, const I& new_components);
+
 public:
 	static void set_specific_name(const entity_handle&, const entity_name_str&);
 	static void clear(cosmos& cosm);
@@ -73,12 +76,12 @@ public:
 	static ref_typed_entity_handle<E> undo_delete_entity(
 		C& cosm,
 		const I undo_delete_input,
-		const entity_solvable<E>& deleted_content,
+		const entity_content<E>& deleted_content,
 		const reinference_type reinference
 	);
 
 	template <class E>
-	static void make_suitable_for_cloning(entity_solvable<E>& solvable);
+	static void make_suitable_for_cloning(entity_content<E>& content);
 
 	template <class handle_type, class P>
 	static auto specific_clone_entity(
@@ -104,4 +107,7 @@ public:
 
 	template <template <class> class Predicate = always_true, class C, class F>
 	static void for_each_entity(C& self, F callback);
+
+	template <class Component, class C, class F>
+	static void for_each_component(C& self, F callback);
 };
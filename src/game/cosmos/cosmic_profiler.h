@@ -1,4 +1,5 @@
 #pragma once
+#include <vector>
 #include "augs/misc/profiler_mixin.h"
 
 struct cosmic_profiler : public augs::profiler_mixin<cosmic_profiler> {
@@ -30,10 +31,12 @@ struct cosmic_profiler : public augs::profiler_mixin<cosmic_profiler> {
 	augs::time_measurements stateful_animations;
 	augs::time_measurements sentiences;
 
+	/* The sum of the longest system of each solve stage, and the sum of all systems. */
+	augs::time_measurements solve_critical_path;
+	augs::time_measurements solve_work;
+
 	augs::time_measurements deserialization_pass = 1;
 
-	augs::time_measurements size_calculation_pass = 1;
-	augs::time_measurements memory_allocation_pass = 1;
 	augs::time_measurements serialization_pass = 1;
 
 	augs::amount_measurements<std::size_t> delta_bytes = 1;
@@ -43,4 +46,7 @@ struct cosmic_profiler : public augs::profiler_mixin<cosmic_profiler> {
 	augs::time_measurements delta_encoding = 1;
 	augs::time_measurements delta_decoding = 1;
 	// END GEN INTROSPECTOR
+
+	/* The longest system of each solve stage, titled with the systems of the stage. */
+	std::vector<augs::time_measurements> solve_stages;
 };
\ No newline at end of file
@@ -12,6 +12,7 @@
 
 #include "augs/readwrite/lua_readwrite.h"
 #include "augs/readwrite/byte_readwrite.h"
+#include "augs/readwrite/write_bytes_field_by_field.h"
 
 #include "game/cosmos/for_each_entity.h"
 
@@ -24,23 +25,80 @@ const cosmos cosmos::zero = {};
 template <class T>
 T cosmos::calculate_solvable_signi_hash() const {
 	if constexpr(std::is_same_v<T, uint32_t>) {
-		augs::memory_stream ss;
+		/*
+			Covers the entire significant state.
 
-		augs::write_bytes(ss, get_clock().now);
-		augs::write_bytes(ss, get_entities_count());
+			Every entity pool is digested separately and only the per-pool digests are folded into the result,
+			so the scratch stream never grows past the size of the biggest pool
+			and is reused between calls without reallocating.
 
-		for_each_having<components::sentience>(
-			[&](const auto& it) {
-				const auto& b = it.template get<components::rigid_body>();
-				const auto& c = b.get_raw_component();
-				const auto& s = it.template get<components::sentience>();
+			Only the live objects and their ids are hashed - never the raw container memory -
+			because unused storage (e.g. past the size of a constant_size_vector) is not transferred over the network
+			and would yield false positives. For the same reason, objects are written field by field,
+			skipping padding, even if they are trivially copyable.
 
-				augs::write_bytes(ss, c);
-				augs::write_bytes(ss, s.meters);
+			The digests are recalculated from scratch every time.
+			Caching them per entity would require knowing which entities have changed,
+			but components are written through mutable accessors that notify nothing.
+		*/
+
+		thread_local augs::memory_stream ss;
+
+		uint32_t result = 0xffffffff;
+
+		auto fold = [&result](const uint32_t digest) {
+			for (std::size_t i = 0; i < sizeof(digest); ++i) {
+				result = updateCRC32(static_cast<unsigned char>(digest >> (i * 8)), result);
+			}
+		};
+
+		auto digest = [&](auto&& write_state) {
+			ss.set_write_pos(0);
+			write_state(ss);
+			fold(crc32buf(reinterpret_cast<char*>(ss.data()), ss.get_write_pos()));
+		};
+
+		const auto& signi = get_solvable().significant;
+
+		digest([&](auto& s) {
+			augs::write_bytes_field_by_field(s, signi.clk);
+		});
+
+		signi.for_each_entity_pool(
+			[&](const auto& p) {
+				const auto pool_size = p.size();
+
+				fold(static_cast<uint32_t>(pool_size));
+
+				if (pool_size == 0) {
+					return;
+				}
+
+				digest([&](auto& s) {
+					p.for_each_id_and_object(
+						[&](const auto& id, const auto& object) {
+							augs::write_bytes_field_by_field(s, id);
+							augs::write_bytes_field_by_field(s, object);
+						}
+					);
+
+					p.for_each_column(
+						[&](const auto& column) {
+							for (const auto& value : column) {
+								augs::write_bytes_field_by_field(s, value);
+							}
+						}
+					);
+				});
 			}
 		);
 
-		return crc32buf(reinterpret_cast<char*>(ss.data()), ss.get_write_pos());
+		digest([&](auto& s) {
+			augs::write_bytes_field_by_field(s, signi.specific_names);
+			augs::write_bytes_field_by_field(s, signi.global);
+		});
+
+		return ~result;
 	}
 	else {
 		static_assert(always_false_v<T>, "Unsupported hash type.");
@@ -116,6 +174,6 @@ void cosmos::set_fixed_delta(const augs::delta& dt) {
 	});
 }
 
-void cosmos::assign_solvable(const cosmos& b) {
-	solvable = b.solvable;
+std::size_t cosmos::assign_solvable(const cosmos& b) {
+	return solvable.assign_changed(b.solvable);
 }
@@ -33,7 +33,7 @@ public:
 	cosmos() = default;
 	explicit cosmos(const cosmic_pool_size_type reserved_entities);
 
-	/* 
+	/*
 		If exception is thrown during alteration,
 		these metods will properly refresh inferred caches with what state was left.
 	*/
@@ -147,6 +147,17 @@ public:
 	template <class... MustHaveComponents, class F>
 	void for_each_having(F&& callback) const;
 
+	/*
+		Passes the handle along with the component.
+		If the component is kept in the columns of entity pools, the columns are walked directly.
+	*/
+
+	template <class Component, class F>
+	void for_each_component(F&& callback);
+
+	template <class Component, class F>
+	void for_each_component(F&& callback) const;
+
 	template <class... MustHaveInvariants, class F>
 	void for_each_flavour_having(F&& callback) const;
 
@@ -269,10 +280,10 @@ public:
 	template <class M>
 	auto measure_raycasts(M& measurement) const {
 		const auto& num_ray_casts = get_solvable_inferred().physics.ray_cast_counter;
-		const auto before = num_ray_casts;
+		const auto before = num_ray_casts.load();
 
 		return augs::scope_guard([&num_ray_casts, &measurement, before](){
-			const auto surplus = num_ray_casts - before;
+			const auto surplus = num_ray_casts.load() - before;
 			measurement.measure(surplus);
 		});
 	}
@@ -295,7 +306,12 @@ public:
 
 	void set_fixed_delta(const augs::delta& dt);
 
-	void assign_solvable(const cosmos& b);
+	/*
+		Copies only the entity pools that changed on either side since the last assignment - see entity_pool_stamps.
+		Returns the number of the copied pools.
+	*/
+
+	std::size_t assign_solvable(const cosmos& b);
 
 	template <class T>
 	T calculate_solvable_signi_hash() const;
@@ -9,6 +9,7 @@
 
 #include "game/common_state/visibility_settings.h"
 #include "game/common_state/pathfinding_settings.h"
+#include "game/common_state/missile_settings.h"
 #include "game/common_state/common_assets.h"
 #include "game/common_state/entity_flavours.h"
 
@@ -41,6 +42,7 @@ struct cosmos_common_significant {
 
 	visibility_settings visibility;
 	pathfinding_settings pathfinding;
+	missile_settings missiles;
 	si_scaling si;
 
 	all_entity_flavours flavours;
@@ -5,12 +5,13 @@
 #include "game/cosmos/cosmos_solvable.hpp"
 #include "game/cosmos/on_entity_meta.h"
 #include "augs/templates/introspection_utils/rewrite_members.h"
-#include "augs/misc/pool/pool_allocate.h"
+#include "augs/misc/pool/column_pool_allocate.h"
 
 const cosmos_solvable cosmos_solvable::zero;
 
 void cosmos_solvable::clear() {
 	destroy_all_caches();
+	significant.pool_stamps.mark_all();
 	significant.entity_pools.clear();
 	significant.clk = {};
 	significant.specific_names.clear();
@@ -39,6 +40,7 @@ static auto make_reserver(const std::size_t n) {
 }
 
 void cosmos_solvable::reserve_storage_for_entities(const cosmic_pool_size_type n) {
+	significant.pool_stamps.mark_all();
 	significant.entity_pools.reserve(n);
 	augs::introspect(make_reserver(n), inferred);
 }
@@ -47,6 +49,8 @@ void cosmos_solvable::destroy_all_caches() {
 	inferred.~cosmos_solvable_inferred();
 	new (&inferred) cosmos_solvable_inferred;
 
+	++num_destroyed_caches;
+
 #if TODO
 	const auto n = significant.entity_pool.capacity();
 
@@ -54,6 +58,16 @@ void cosmos_solvable::destroy_all_caches() {
 #endif
 }
 
+std::size_t cosmos_solvable::assign_changed(const cosmos_solvable& from) {
+	num_destroyed_caches = from.num_destroyed_caches;
+	num_pool_changes = from.num_pool_changes;
+
+	const auto num_copied_pools = significant.assign_changed(from.significant);
+	inferred = from.inferred;
+
+	return num_copied_pools;
+}
+
 void cosmos_solvable::increment_step() {
 	++significant.clk.now.step;
 }
@@ -91,9 +105,11 @@ unsigned cosmos_solvable::get_steps_per_second() const {
 }
 
 std::optional<cosmic_pool_undo_free_input> cosmos_solvable::free_entity(const entity_id id) {
+	++num_pool_changes[id.type_id.get_index()];
 	return significant.on_pool(id.type_id, [id](auto& p){ return p.free(id.raw); });
 }
 
 void cosmos_solvable::undo_last_allocate_entity(const entity_id id) {
+	++num_pool_changes[id.type_id.get_index()];
 	return significant.on_pool(id.type_id, [id](auto& p){ return p.undo_last_allocate(id.raw); });
 }
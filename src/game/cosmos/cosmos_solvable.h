@@ -10,6 +10,7 @@
 #include "game/organization/all_components_declaration.h"
 #endif
 
+#include "game/cosmos/per_entity_type.h"
 #include "game/cosmos/cosmos_solvable_inferred.h"
 #include "game/cosmos/cosmos_solvable_significant.h"
 #include "game/cosmos/entity_id.h"
@@ -22,6 +23,14 @@ struct entity_creation_input {
 class cosmos_solvable {
 	static const cosmos_solvable zero;
 
+	unsigned num_destroyed_caches = 0;
+	per_entity_type_array<unsigned> num_pool_changes = {};
+
+	template <class E>
+	void note_pool_change() {
+		++num_pool_changes[entity_type_id::get_index_of<E>()];
+	}
+
 	template <class A, class B>
 	struct allocation_result {
 		A key;
@@ -67,6 +76,20 @@ public:
 
 	void destroy_all_caches();
 
+	/* The assignment that copies only the changed entity pools, used to clone the state for reprediction. */
+	std::size_t assign_changed(const cosmos_solvable& from);
+
+	/* Lets the caches outside of the cosmos notice that the state was replaced in place. */
+	auto get_num_destroyed_caches() const {
+		return num_destroyed_caches;
+	}
+
+	/* Counts the entities of a type created and deleted, so that a deletion followed by a creation is noticed too. */
+	template <class E>
+	auto get_num_pool_changes() const {
+		return num_pool_changes[entity_type_id::get_index_of<E>()];
+	}
+
 	void increment_step();
 	void clear();
 
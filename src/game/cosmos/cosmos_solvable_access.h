@@ -29,6 +29,10 @@ class cosmos_solvable_access {
 
 	friend editor_property_accessors;
 
+	/* For the components kept in the columns of entity pools */
+	template <bool, class, template <class> class>
+	friend class specific_entity_handle;
+
 	template <class C, class E>
 	friend auto subscript_handle_getter(C& cosm, typed_entity_id<E>) 
 		-> basic_typed_entity_handle<std::is_const_v<C>, E>
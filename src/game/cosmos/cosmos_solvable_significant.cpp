@@ -2,10 +2,135 @@
 
 #include "augs/readwrite/memory_stream.h"
 
+#include "augs/templates/introspect.h"
+
 #include "game/organization/all_component_includes.h"
+#include "game/organization/for_each_entity_type.h"
 #include "game/cosmos/cosmos.h"
 
+entity_pool_stamps::stamp_type entity_pool_stamps::make_fresh_stamp() {
+	static std::atomic<stamp_type> last_stamp = 0;
+	return ++last_stamp;
+}
+
+std::size_t cosmos_solvable_significant::assign_changed(const cosmos_solvable_significant& from) {
+	std::size_t num_copied = 0;
+
+	pool_stamps.stamp_changed();
+	from.pool_stamps.stamp_changed();
+
+	augs::introspect(
+		[&](auto, auto& into, const auto& source) {
+			using T = remove_cref<decltype(into)>;
+
+			if constexpr(std::is_same_v<T, all_entity_pools>) {
+				for_each_entity_type([&](auto e) {
+					using E = decltype(e);
+
+					if (!pool_stamps.same_contents<E>(from.pool_stamps)) {
+						into.template get_for<E>() = source.template get_for<E>();
+						++num_copied;
+					}
+				});
+			}
+			else {
+				into = source;
+			}
+		},
+		*this,
+		from
+	);
+
+	pool_stamps = from.pool_stamps;
+	assignment_detector = from.assignment_detector;
+
+	return num_copied;
+}
+
 void cosmos_solvable_significant::clear() {
 	*this = cosmos_solvable_significant();
 	global.clear();
-}
\ No newline at end of file
+}
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+
+#include "augs/misc/lua/lua_utils.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "game/modes/test_mode.h"
+#include "application/intercosm.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+
+TEST_CASE("CosmosSolvableSignificant AssignChanged") {
+	auto lua = augs::create_lua_state();
+
+	/* Intercosm is too big for the stack. */
+	const auto scene = std::make_unique<intercosm>();
+	test_mode_ruleset ruleset;
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	auto& referential = scene->world;
+
+	const auto origin = transformr(vec2(100000.f, 100000.f), 0.f);
+	const auto moved = transformr(vec2(100100.f, 100000.f), 0.f);
+
+	const auto decoration = create_test_scene_entity(referential, test_sprite_decorations::AQUARIUM_SAND_1, origin.pos).get_id();
+
+	const auto entropy = cosmic_entropy();
+	const auto settings = solve_settings();
+
+	auto advance = [&](cosmos& advanced, const int num_steps) {
+		for (int i = 0; i < num_steps; ++i) {
+			standard_solver()(
+				logic_step_input { advanced, entropy, settings },
+				solver_callbacks()
+			);
+		}
+	};
+
+	auto hash_of = [](const cosmos& cosm) {
+		return cosm.calculate_solvable_signi_hash<uint32_t>();
+	};
+
+	auto transform_of = [&](const cosmos& cosm) {
+		return cosm[decoration].get_logic_transform();
+	};
+
+	/* Too big for the stack. */
+	const auto predicted_ptr = std::make_unique<cosmos>();
+	auto& predicted = *predicted_ptr;
+
+	predicted = referential;
+	predicted.assign_solvable(referential);
+
+	/* Nothing changed on either side since the last assignment. */
+	REQUIRE(predicted.assign_solvable(referential) == 0);
+
+	/* Only the pool of the changed decoration is copied, whichever side changed it. */
+
+	predicted[decoration].set_logic_transform(moved);
+	REQUIRE(predicted.assign_solvable(referential) == 1);
+	REQUIRE(transform_of(predicted) == origin);
+
+	referential[decoration].set_logic_transform(moved);
+	REQUIRE(predicted.assign_solvable(referential) == 1);
+	REQUIRE(transform_of(predicted) == moved);
+
+	/* Just like reprediction: the predicted cosmos runs ahead, then gets reset to the referential one. */
+
+	for (int i = 0; i < 5; ++i) {
+		advance(referential, 1);
+		advance(predicted, 3);
+
+		predicted.assign_solvable(referential);
+		REQUIRE(hash_of(predicted) == hash_of(referential));
+	}
+
+	advance(referential, 60);
+	advance(predicted, 60);
+
+	REQUIRE(hash_of(predicted) == hash_of(referential));
+}
+#endif
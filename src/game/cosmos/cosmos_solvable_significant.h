@@ -1,12 +1,15 @@
 #pragma once
 #include <map>
 #include "augs/misc/constant_size_vector.h"
+#include "augs/misc/paged_vector.h"
 #include "augs/misc/pool/pool.h"
+#include "augs/misc/pool/column_pool.h"
 
 #include "augs/templates/get_by_dynamic_id.h"
 
 #include "game/cosmos/entity_pools.h"
 #include "game/cosmos/entity_solvable.h"
+#include "game/cosmos/entity_pool_stamps.h"
 
 #include "game/common_state/entity_name_str.h"
 #include "game/cosmos/entity_id.h"
@@ -27,8 +30,12 @@ struct cosmos_solvable_significant {
 
 	mutable augs::assignment_detector assignment_detector;
 
+	/* Mutable since the source of an assignment gets stamped too. */
+	mutable entity_pool_stamps pool_stamps;
+
 	template <class E>
 	auto& get_pool() {
+		pool_stamps.mark<E>();
 		return entity_pools.get_for<E>();
 	}
 
@@ -39,6 +46,7 @@ struct cosmos_solvable_significant {
 
 	template <class F>
 	decltype(auto) on_pool(const entity_type_id id, F&& callback) {
+		pool_stamps.mark(id);
 		return entity_pools.visit(id, std::forward<F>(callback));
 	}
 
@@ -49,6 +57,7 @@ struct cosmos_solvable_significant {
 
 	template <class F>
 	decltype(auto) for_each_entity_pool(F&& callback) {
+		pool_stamps.mark_all();
 		return entity_pools.for_each_container(std::forward<F>(callback));
 	}
 
@@ -57,5 +66,13 @@ struct cosmos_solvable_significant {
 		return entity_pools.for_each_container(std::forward<F>(callback));
 	}
 
+	/*
+		Has the same outcome as the assignment,
+		but copies only the entity pools whose contents differ from those of the source - see entity_pool_stamps.
+		Returns the number of the copied pools.
+	*/
+
+	std::size_t assign_changed(const cosmos_solvable_significant& from);
+
 	void clear();
 };
\ No newline at end of file
@@ -1,6 +1,7 @@
 #pragma once
+#include "augs/templates/for_each_std_get.h"
 #include "game/cosmos/entity_construction.h"
-#include "augs/misc/pool/pool_allocate.h"
+#include "augs/misc/pool/column_pool_allocate.h"
 #include "game/cosmos/cosmic_functions.h"
 #include "game/detail/entity_handle_mixins/get_current_slot.hpp"
 #include "game/cosmos/entity_creation_error.h"
@@ -21,10 +22,7 @@ ref_typed_entity_handle<E> cosmic::specific_create_entity_detail(
 	const auto new_allocation = cosm.get_solvable({}).template allocate_next_entity<E>({ flavour_id.raw });
 	const auto handle = ref_typed_entity_handle<E> { cosm, { new_allocation.object, new_allocation.key } };
 
-	{
-		auto& object = new_allocation.object;
-		object.components = initial_components;
-	}
+	assign_components(handle, initial_components);
 
 	pre_construction(handle, handle.get({}));
 	construct_pre_inference(handle);
@@ -100,19 +98,31 @@ entity_handle cosmic::create_entity(
 	);
 }
 
+template <class handle_type, class I>
+void cosmic::assign_components(const handle_type handle, const I& new_components) {
+	for_each_through_std_get(new_components, [&handle](const auto& c) {
+		using C = remove_cref<decltype(c)>;
+		handle.template get_component<C>({}) = c;
+	});
+}
+
 template <class C, class I, class E>
 ref_typed_entity_handle<E> cosmic::undo_delete_entity(
 	C& cosm,
 	const I undo_delete_input,
-	const entity_solvable<E>& deleted_content,
+	const entity_content<E>& deleted_content,
 	const reinference_type reinference
 ) {
 	auto& s = cosm.get_solvable({});
 
-	const auto new_allocation = s.template undo_free_entity<E>(undo_delete_input, deleted_content);
-	new_allocation.object.components = deleted_content.components;
-	
+	const auto new_allocation = s.template undo_free_entity<E>(
+		undo_delete_input, 
+		deleted_content.flavour_id, 
+		deleted_content.when_born
+	);
+
 	const auto handle = ref_typed_entity_handle<E> { cosm, { new_allocation.object, new_allocation.key } };
+	assign_components(handle, deleted_content.components);
 
 	if (reinference == reinference_type::ONLY_AFFECTED) {
 		infer_caches_for(handle);
@@ -125,11 +135,9 @@ ref_typed_entity_handle<E> cosmic::undo_delete_entity(
 }
 
 template <class E>
-void cosmic::make_suitable_for_cloning(entity_solvable<E>& solvable) {
-	auto& new_components = solvable.components;
-
-	if constexpr(entity_solvable<E>::template has<components::item>()) {
-		std::get<components::item>(new_components).clear_slot_info();
+void cosmic::make_suitable_for_cloning(entity_content<E>& content) {
+	if constexpr(entity_content<E>::template has<components::item>()) {
+		content.template get<components::item>().clear_slot_info();
 	}
 }
 
@@ -141,14 +149,11 @@ auto cosmic::specific_clone_entity(
 	auto& cosm = source_entity.get_cosmos();
 
 	return cosmic::specific_create_entity(cosm, source_entity.get_flavour_id(), [&](const auto new_entity, auto&&...) {
-		const auto& source_components = source_entity.get({}).components;
-		auto& new_solvable = new_entity.get({});
-		auto& new_components = new_solvable.components;
+		auto content = source_entity.get_content();
+		cosmic::make_suitable_for_cloning(content);
 
 		/* Initial copy-assignment */
-		new_components = source_components; 
-
-		cosmic::make_suitable_for_cloning(new_solvable);
+		cosmic::assign_components(new_entity, content.components);
 
 		pre_construction(new_entity);
 
@@ -176,6 +181,7 @@ auto cosmos_solvable::allocate_new_entity(const entity_creation_input in) {
 	}
 
 	const auto result = pool.allocate(in.flavour_id, get_timestamp());
+	note_pool_change<E>();
 
 	allocation_result<typed_entity_id<E>, decltype(result.object)> output {
 		typed_entity_id<E>(result.key), result.object
@@ -188,6 +194,7 @@ template <class E, class... Args>
 auto cosmos_solvable::detail_undo_free_entity(Args&&... args) {
 	auto& pool = significant.get_pool<E>();
 	const auto result = pool.undo_free(std::forward<Args>(args)...);
+	note_pool_change<E>();
 
 	allocation_result<typed_entity_id<E>, decltype(result.object)> output {
 		typed_entity_id<E>(result.key), result.object
@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+#include "game/cosmos/per_entity_type.h"
+
+/*
+	Stamps the contents of the entity pools,
+	so that assigning the state from another cosmos copies only the pools whose contents differ.
+
+	Every mutable access to a pool marks it as changed - whether anything gets written or not.
+	Right before an assignment, the changed pools of both sides get fresh stamps, unique within the program,
+	and a copied pool takes the stamp of its source. Equal stamps thus always mean equal contents.
+
+	A plain copy takes the stamps and the marks as they are,
+	so the first assignment between a cosmos and its fresh copy might still copy the pools that were marked before.
+
+	The marks are atomic as the systems of a solve stage might run concurrently.
+*/
+
+class entity_pool_stamps {
+	using stamp_type = uint64_t;
+
+	struct changed_mark {
+		std::atomic<bool> value = true;
+
+		changed_mark() = default;
+
+		changed_mark(const changed_mark& b) : value(b.value.load(std::memory_order_relaxed)) {}
+
+		changed_mark& operator=(const changed_mark& b) {
+			value.store(b.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			return *this;
+		}
+	};
+
+	per_entity_type_array<stamp_type> stamps = {};
+	per_entity_type_array<changed_mark> changed;
+
+	static stamp_type make_fresh_stamp();
+
+public:
+	void mark(const entity_type_id id) {
+		changed[id.get_index()].value.store(true, std::memory_order_relaxed);
+	}
+
+	template <class E>
+	void mark() {
+		changed[entity_type_id::get_index_of<E>()].value.store(true, std::memory_order_relaxed);
+	}
+
+	void mark_all() {
+		for (auto& c : changed) {
+			c.value.store(true, std::memory_order_relaxed);
+		}
+	}
+
+	void stamp_changed() {
+		for (std::size_t i = 0; i < stamps.size(); ++i) {
+			if (changed[i].value.exchange(false, std::memory_order_relaxed)) {
+				stamps[i] = make_fresh_stamp();
+			}
+		}
+	}
+
+	/* Both sides must have been stamped first. */
+
+	template <class E>
+	bool same_contents(const entity_pool_stamps& b) const {
+		const auto i = entity_type_id::get_index_of<E>();
+		return stamps[i] == b.stamps[i];
+	}
+};
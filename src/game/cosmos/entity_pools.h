@@ -7,18 +7,34 @@
 #include "game/organization/all_entity_types.h"
 
 #include "game/cosmos/pool_size_type.h"
+#include "game/cosmos/entity_type_traits.h"
 #include "game/cosmos/per_entity_type.h"
 
 static constexpr bool statically_allocate_entities = STATICALLY_ALLOCATE_ENTITIES;
+static constexpr bool paged_entity_pools = PAGED_ENTITY_POOLS;
+
+static constexpr unsigned entity_pool_page_size = 256;
 
 template <class E>
 struct entity_solvable;
 
+/*
+	The soa_components of an entity type live in columns parallel to the array of its entity_solvables,
+	so that the systems which only read e.g. the interpolation of all entities do not drag whole entities through the cache.
+
+	Paged pools grow in pages of entity_pool_page_size entities and a copy of the cosmos only copies the pages in use,
+	instead of the whole statically allocated storage.
+*/
+
 template <class T>
 using make_entity_pool = std::conditional_t<
-	statically_allocate_entities,
-	augs::pool<entity_solvable<T>, of_size<T::statically_allocated_entities>::template make_nontrivial_constant_vector, cosmic_pool_size_type>,
-	augs::pool<entity_solvable<T>, make_vector, cosmic_pool_size_type>
+	paged_entity_pools,
+	augs::column_pool<entity_solvable<T>, soa_components_of<T>, of_page_size<entity_pool_page_size>::template make_paged_vector, cosmic_pool_size_type>,
+	std::conditional_t<
+		statically_allocate_entities,
+		augs::column_pool<entity_solvable<T>, soa_components_of<T>, of_size<T::statically_allocated_entities>::template make_nontrivial_constant_vector, cosmic_pool_size_type>,
+		augs::column_pool<entity_solvable<T>, soa_components_of<T>, make_vector, cosmic_pool_size_type>
+	>
 >;
 
 using all_entity_pools = per_entity_type_container<make_entity_pool>;
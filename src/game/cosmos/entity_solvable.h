@@ -24,10 +24,16 @@ struct entity_solvable_meta {
 	{}
 };
 
+/*
+	The soa_components of an entity type are not stored here, 
+	but in the columns of its entity pool - see entity_pools.h.
+	Access them through the handle.
+*/
+
 template <class E>
 struct entity_solvable : entity_solvable_meta {
 	using used_entity_type = E;
-	using components_type = make_components<E>;
+	using components_type = make_aos_components<E>;
 	using entity_solvable_meta::entity_solvable_meta;
 	using introspect_base = entity_solvable_meta;
 
@@ -35,8 +41,14 @@ struct entity_solvable : entity_solvable_meta {
 	components_type components;	
 	// END GEN INTROSPECTOR
 
+	/* Also true for the components stored in the columns of the pool. */
 	template <class C>
 	static constexpr bool has() {
+		return is_one_of_list_v<C, components_of<E>>;
+	}
+
+	template <class C>
+	static constexpr bool has_inline() {
 		return is_one_of_list_v<C, components_type>;
 	}
 
@@ -60,3 +72,35 @@ struct entity_solvable : entity_solvable_meta {
 		for_each_through_std_get(components, std::forward<F>(callback));
 	}
 };
+
+/* 
+	A complete copy of an entity, along with the components kept in the columns of its pool.
+	Used wherever an entity must be stored outside of the cosmos, e.g. by the editor commands.
+*/
+
+template <class E>
+struct entity_content : entity_solvable_meta {
+	using used_entity_type = E;
+	using components_type = make_components<E>;
+	using entity_solvable_meta::entity_solvable_meta;
+	using introspect_base = entity_solvable_meta;
+
+	// GEN INTROSPECTOR struct entity_content class E
+	components_type components;	
+	// END GEN INTROSPECTOR
+
+	template <class C>
+	static constexpr bool has() {
+		return is_one_of_list_v<C, components_type>;
+	}
+
+	template <class C>
+	auto& get() {
+		return std::get<C>(components);
+	}
+
+	template <class C>
+	const auto& get() const {
+		return std::get<C>(components);
+	}
+};
@@ -3,6 +3,7 @@
 #include "augs/misc/trivially_copyable_tuple.h"
 
 #include "augs/templates/list_utils.h"
+#include "augs/templates/folded_finders.h"
 #include "augs/templates/type_mod_templates.h"
 #include "augs/templates/transform_types.h"
 #include "augs/templates/filter_types.h"
@@ -24,6 +25,33 @@ using components_of = typename T::components;
 template <class T>
 using invariants_and_components_of = concatenate_lists_t<invariants_of<T>, components_of<T>>;
 
+/*
+	Components that an entity type lists in soa_components are stored in separate columns of its entity pool,
+	not inside the entity_solvable - see entity_pools.h.
+*/
+
+template <class T, class = void>
+struct soa_components_of_detail {
+	using type = type_list<>;
+};
+
+template <class T>
+struct soa_components_of_detail<T, std::void_t<typename T::soa_components>> {
+	using type = typename T::soa_components;
+};
+
+template <class T>
+using soa_components_of = typename soa_components_of_detail<T>::type;
+
+template <class T>
+struct is_aos_component_of {
+	template <class C>
+	struct type : std::bool_constant<!is_one_of_list_v<C, soa_components_of<T>>> {};
+};
+
+template <class T>
+using aos_components_of = filter_types_in_list_t<is_aos_component_of<T>::template type, components_of<T>>;
+
 template <class T>
 using make_invariants = 
 	std::conditional_t<
@@ -42,6 +70,15 @@ using make_components =
 	>
 ;
 
+template <class T>
+using make_aos_components = 
+	std::conditional_t<
+		all_in_list_are_v<std::is_trivially_copyable, aos_components_of<T>>,
+		replace_list_type_t<aos_components_of<T>, augs::trivially_copyable_tuple>,
+		replace_list_type_t<aos_components_of<T>, std::tuple>
+	>
+;
+
 template <template <class> class Predicate>
 using entity_types_passing = filter_types_in_list_t<Predicate, all_entity_types>;
 
@@ -17,6 +17,35 @@ void cosmic::for_each_entity(C& self, F callback) {
 	);
 }
 
+template <class Component, class C, class F>
+void cosmic::for_each_component(C& self, F callback) {
+	for_each_entity_type([&](auto e) {
+		using E = decltype(e);
+
+		if constexpr(has_all_of_v<E, Component>) {
+			auto& p = self.get_solvable({}).significant.template get_pool<E>();
+
+			using pool_type = remove_cref<decltype(p)>;
+			using index_type = typename pool_type::used_size_type;
+			using iterated_handle_type = basic_iterated_entity_handle<is_const_ref_v<decltype(p.get_nth(0))>, E>;
+
+			if constexpr(pool_type::template has_column<Component>()) {
+				auto& column = p.template get_column<Component>();
+
+				for (index_type i = 0; i < p.size(); ++i) {
+					callback(iterated_handle_type(self, { p.get_nth(i), i }), column[i]);
+				}
+			}
+			else {
+				for (index_type i = 0; i < p.size(); ++i) {
+					auto& object = p.get_nth(i);
+					callback(iterated_handle_type(self, { object, i }), object.template get<Component>());
+				}
+			}
+		}
+	});
+}
+
 template <class... MustHaveComponents, class F>
 void cosmos::for_each_having(F&& callback) {
 	cosmic::for_each_entity<has_all_of<MustHaveComponents...>::template type>(*this, std::forward<F>(callback));
@@ -27,6 +56,16 @@ void cosmos::for_each_having(F&& callback) const {
 	cosmic::for_each_entity<has_all_of<MustHaveComponents...>::template type>(*this, std::forward<F>(callback));
 }
 
+template <class Component, class F>
+void cosmos::for_each_component(F&& callback) {
+	cosmic::for_each_component<Component>(*this, std::forward<F>(callback));
+}
+
+template <class Component, class F>
+void cosmos::for_each_component(F&& callback) const {
+	cosmic::for_each_component<Component>(*this, std::forward<F>(callback));
+}
+
 template <template <class> class Predicate, class F>
 void cosmos::for_each_entity(F&& callback) {
 	cosmic::for_each_entity<Predicate>(*this, std::forward<F>(callback));
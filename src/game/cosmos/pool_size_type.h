@@ -1,3 +1,9 @@
 #pragma once
 
+/* Paged pools can hold more entities of a single type than unsigned short could index. */
+
+#if PAGED_ENTITY_POOLS
+using cosmic_pool_size_type = unsigned;
+#else
 using cosmic_pool_size_type = unsigned short;
+#endif
@@ -24,6 +24,10 @@ public:
 		return solvable;
 	}
 
+	auto assign_changed(const private_cosmos_solvable& from) {
+		return solvable.assign_changed(from.solvable);
+	}
+
 	auto& get_solvable_inferred(cosmos_solvable_inferred_access) {
 		return solvable.inferred;
 	}
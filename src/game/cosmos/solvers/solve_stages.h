@@ -0,0 +1,107 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+
+#include "augs/misc/enum/enum_boolset.h"
+
+/*
+	State that the systems of a solve declare to read or write.
+
+	Only the state touched by systems that can share a stage with others is listed here.
+	A system that touches anything else - creates or deletes entities, posts the messages read by other systems,
+	moves physical bodies and so on - is declared exclusive instead.
+*/
+
+enum class solve_resource {
+	TRANSFORMS,
+	SENTIENCES,
+	CROSSHAIRS,
+	TRACES,
+	ANIMATIONS,
+	CONTINUOUS_PARTICLES,
+	REMNANTS,
+
+	EVENT_MESSAGES,
+	PARTICLE_EFFECT_MESSAGES,
+	SOUND_EFFECT_MESSAGES,
+	QUEUED_DELETIONS,
+
+	STEP_RNG,
+	DEBUG_LINES,
+
+	COUNT
+};
+
+using solve_resources = augs::enum_boolset<solve_resource>;
+
+struct solve_access {
+	solve_resources reads;
+	solve_resources writes;
+
+	/* Might touch anything, so it always runs alone and never moves past another system. */
+	bool exclusive = false;
+
+	static solve_access make_exclusive() {
+		solve_access out;
+		out.exclusive = true;
+		return out;
+	}
+
+	bool conflicts_with(const solve_access& b) const {
+		if (exclusive || b.exclusive) {
+			return true;
+		}
+
+		for (std::size_t i = 0; i < static_cast<std::size_t>(solve_resource::COUNT); ++i) {
+			const bool a_writes = writes.test(i);
+			const bool b_writes = b.writes.test(i);
+
+			if (a_writes && (b_writes || b.reads.test(i))) {
+				return true;
+			}
+
+			if (b_writes && reads.test(i)) {
+				return true;
+			}
+		}
+
+		return false;
+	}
+};
+
+/*
+	Groups the systems, given in their declared order, into stages that run one after another.
+
+	A system lands in the first stage after those of all earlier systems it conflicts with.
+	Conflicting systems thus keep their declared order,
+	and the systems within a single stage touch disjoint state,
+	so the outcome does not depend on the order in which a stage runs its systems.
+
+	Returns the indices of the systems in each stage.
+*/
+
+template <class S>
+auto make_solve_stages(const std::vector<S>& systems) {
+	std::vector<std::vector<std::size_t>> stages;
+	std::vector<std::size_t> stage_of(systems.size(), 0);
+
+	for (std::size_t i = 0; i < systems.size(); ++i) {
+		std::size_t stage = 0;
+
+		for (std::size_t j = 0; j < i; ++j) {
+			if (systems[i].access.conflicts_with(systems[j].access)) {
+				stage = std::max(stage, stage_of[j] + 1);
+			}
+		}
+
+		stage_of[i] = stage;
+
+		if (stage == stages.size()) {
+			stages.emplace_back();
+		}
+
+		stages[stage].push_back(i);
+	}
+
+	return stages;
+}
@@ -9,4 +9,7 @@ struct solve_result {
 struct solve_settings {
 	effect_prediction_settings effect_prediction;
 	entity_id disable_knockouts;
+
+	/* Workers that run the systems sharing a solve stage. 0 runs everything on the calling thread. */
+	unsigned num_additional_workers = 0;
 };
@@ -1,3 +1,9 @@
+#include <vector>
+
+#include "augs/misc/timing/timer.h"
+#include "augs/misc/trace_recording.h"
+#include "augs/templates/range_workers.h"
+
 #include "game/organization/all_messages_includes.h"
 #include "game/organization/all_component_includes.h"
 
@@ -6,6 +12,7 @@
 #include "game/cosmos/cosmic_functions.h"
 #include "game/cosmos/entity_handle.h"
 #include "game/cosmos/data_living_one_step.h"
+#include "game/cosmos/solvers/solve_stages.h"
 
 #include "game/detail/inventory/perform_transfer.h"
 #include "game/detail/physics/contact_listener.h"
@@ -43,10 +50,299 @@
 #include <random>
 #endif
 
+/*
+	The systems of the standard solve, in their declared order.
+	Each declares the state it touches, and systems that touch disjoint state may run concurrently -
+	see make_solve_stages.
+
+	The grouped systems share a single entry when they are measured together.
+*/
+
+struct standard_solve_context {
+	contact_listener& listener;
+};
+
+struct standard_solve_system {
+	const char* name;
+	solve_access access;
+	void (*run)(logic_step, standard_solve_context&);
+};
+
+static std::vector<standard_solve_system> make_standard_solve_systems() {
+	using R = solve_resource;
+	const auto exclusive = solve_access::make_exclusive();
+
+	return {
+		{ "cast spells", exclusive, [](const logic_step step, standard_solve_context&) {
+			sentience_system().cast_spells(step);
+		} },
+
+		{ "input", exclusive, [](const logic_step step, standard_solve_context&) {
+			input_system().make_input_messages(step);
+		} },
+
+		{ "intent contextualization", exclusive, [](const logic_step step, standard_solve_context&) {
+			intent_contextualization_system().contextualize_crosshair_action_intents(step);
+			intent_contextualization_system().contextualize_movement_intents(step);
+
+			intent_contextualization_system().handle_use_button_presses(step);
+			intent_contextualization_system().advance_use_button(step);
+		} },
+
+		{ "movement paths", exclusive, [](const logic_step step, standard_solve_context&) {
+			auto scope = measure_scope(step.get_cosmos().profiler.movement_paths);
+			movement_path_system().advance_paths(step);
+		} },
+
+		{ "stateful animations", { {}, { R::ANIMATIONS, R::QUEUED_DELETIONS } }, [](const logic_step step, standard_solve_context&) {
+			auto scope = measure_scope(step.get_cosmos().profiler.stateful_animations);
+			animation_system().advance_stateful_animations(step);
+		} },
+
+		{ "movement", exclusive, [](const logic_step step, standard_solve_context&) {
+			movement_system().set_movement_flags_from_input(step);
+			movement_system().apply_movement_forces(step);
+		} },
+
+		{ "crosshairs and melee", exclusive, [](const logic_step step, standard_solve_context&) {
+			crosshair_system().handle_crosshair_intents(step);
+			crosshair_system().update_base_offsets(step);
+			melee_system().initiate_and_update_moves(step);
+			sentience_system().rotate_towards_crosshairs_and_driven_vehicles(step);
+		} },
+
+		{ "shots", exclusive, [](const logic_step step, standard_solve_context&) {
+			gun_system().launch_shots_due_to_pressed_triggers(step);
+		} },
+
+		{ "cars", exclusive, [](const logic_step step, standard_solve_context&) {
+			car_system().set_steering_flags_from_intents(step);
+			car_system().apply_movement_forces(step);
+		} },
+
+		{ "thrown melee", exclusive, [](const logic_step step, standard_solve_context&) {
+			melee_system().advance_thrown_melee_logic(step);
+		} },
+
+		{ "items", exclusive, [](const logic_step step, standard_solve_context&) {
+			force_joint_system().apply_forces_towards_target_entities(step);
+			item_system().handle_throw_item_intents(step);
+			item_system().handle_reload_intents(step);
+			item_system().advance_reloading_contexts(step);
+			step.get_cosmos().get_global_solvable().solve_item_mounting(step);
+			item_system().handle_wielding_requests(step);
+		} },
+
+		{ "explosives", exclusive, [](const logic_step step, standard_solve_context&) {
+			auto scope = measure_scope(step.get_cosmos().profiler.explosives);
+
+			demolitions_system().detonate_fuses(step);
+			demolitions_system().advance_cascade_explosions(step);
+		} },
+
+		{ "physics", exclusive, [](const logic_step step, standard_solve_context& context) {
+			context.listener.during_step = true;
+			physics_system().step_and_set_new_transforms(step);
+			context.listener.during_step = false;
+
+			physics_system().post_and_clear_accumulated_collision_messages(step);
+		} },
+
+		{ "trace lengthening", { {}, { R::TRACES } }, [](const logic_step step, standard_solve_context&) {
+			trace_system().lengthen_sprites_of_traces(step);
+		} },
+
+		{ "crosshair recoils", { {}, { R::CROSSHAIRS, R::SENTIENCES } }, [](const logic_step step, standard_solve_context&) {
+			crosshair_system().integrate_crosshair_recoils(step);
+		} },
+
+		{ "item pickups", exclusive, [](const logic_step step, standard_solve_context&) {
+			item_system().pick_up_touching_items(step);
+		} },
+
+		{ "missiles", exclusive, [](const logic_step step, standard_solve_context&) {
+			auto scope = measure_scope(step.get_cosmos().profiler.missiles);
+
+			missile_system().advance_swept_missiles(step);
+			missile_system().ricochet_missiles(step);
+			missile_system().detonate_colliding_missiles(step);
+			missile_system().detonate_expired_missiles(step);
+		} },
+
+		{ "destruction", exclusive, [](const logic_step step, standard_solve_context&) {
+			destruction_system().generate_damages_from_forceful_collisions(step);
+			destruction_system().apply_damages_and_split_fixtures(step);
+		} },
+
+		{ "sentiences", exclusive, [](const logic_step step, standard_solve_context&) {
+			auto scope = measure_scope(step.get_cosmos().profiler.sentiences);
+
+			sentience_system().process_special_results_of_health_events(step);
+			sentience_system().regenerate_values_and_advance_spell_logic(step);
+			sentience_system().apply_damage_and_generate_health_events(step);
+			sentience_system().cooldown_aimpunches(step);
+		} },
+
+		{ "drivers", exclusive, [](const logic_step step, standard_solve_context&) {
+			driver_system().release_drivers_due_to_requests(step);
+			driver_system().assign_drivers_who_touch_wheels(step);
+			driver_system().release_drivers_due_to_ending_contact_with_wheel(step);
+		} },
+
+		{ 
+			"particles from events", 
+			{ { R::EVENT_MESSAGES, R::TRANSFORMS, R::SENTIENCES }, { R::PARTICLE_EFFECT_MESSAGES } }, 
+			[](const logic_step step, standard_solve_context&) {
+				particles_existence_system().play_particles_from_events(step);
+			} 
+		},
+
+		{ 
+			"stream displacement", 
+			{ { R::TRANSFORMS }, { R::CONTINUOUS_PARTICLES, R::STEP_RNG, R::DEBUG_LINES } }, 
+			[](const logic_step step, standard_solve_context&) {
+				particles_existence_system().displace_streams(step);
+			} 
+		},
+
+		{ 
+			"sounds from events", 
+			{ { R::EVENT_MESSAGES, R::TRANSFORMS, R::SENTIENCES }, { R::SOUND_EFFECT_MESSAGES, R::STEP_RNG } }, 
+			[](const logic_step step, standard_solve_context&) {
+				sound_existence_system().play_sounds_from_events(step);
+			} 
+		},
+
+		{ "visibility", exclusive, [](const logic_step step, standard_solve_context&) {
+			auto& cosm = step.get_cosmos();
+			auto& performance = cosm.profiler;
+
+			auto scope = measure_scope(performance.visibility);
+			auto visibility_raycasts_scope = cosm.measure_raycasts(performance.visibility_raycasts);
+
+			visibility_system(DEBUG_LOGIC_STEP_LINES).calc_visibility(step);
+		} },
+
+		{ "ai", exclusive, [](const logic_step step, standard_solve_context&) {
+			auto scope = measure_scope(step.get_cosmos().profiler.ai);
+			behaviour_tree_system().evaluate_trees(step);
+		} },
+
+		{ "pathfinding", exclusive, [](const logic_step step, standard_solve_context&) {
+			auto& cosm = step.get_cosmos();
+			auto& performance = cosm.profiler;
+
+			auto pathfinding_raycasts_scope = cosm.measure_raycasts(performance.pathfinding_raycasts);
+
+			auto scope = measure_scope(performance.pathfinding);
+			pathfinding_system().advance_pathfinding_sessions(step);
+		} },
+
+		{ "transfers", exclusive, [](const logic_step step, standard_solve_context&) {
+			auto& transfers = step.get_queue<item_slot_transfer_request>();
+			perform_transfers(transfers, step);
+		} },
+
+		{ "trace expiration", { {}, { R::TRACES, R::QUEUED_DELETIONS } }, [](const logic_step step, standard_solve_context&) {
+			trace_system().destroy_outdated_traces(step);
+		} },
+
+		{ "remnants", { {}, { R::REMNANTS, R::QUEUED_DELETIONS } }, [](const logic_step step, standard_solve_context&) {
+			remnant_system().shrink_and_destroy_remnants(step);
+		} }
+	};
+}
+
+struct standard_solve_task {
+	const standard_solve_system* system = nullptr;
+	double secs = 0.0;
+};
+
+struct standard_solve_task_runner {
+	logic_step step;
+	standard_solve_context& context;
+
+	void operator()(standard_solve_task& task) const {
+		augs::timer t;
+		task.system->run(step, context);
+		task.secs = t.get<std::chrono::seconds>();
+
+		if (augs::is_trace_recording()) {
+			augs::record_trace_interval(task.system->name, task.secs);
+		}
+	}
+};
+
+static void run_standard_solve_stages(const logic_step step, standard_solve_context& context) {
+	static const auto systems = make_standard_solve_systems();
+	static const auto stages = make_solve_stages(systems);
+
+	auto& performance = step.get_cosmos().profiler;
+	auto& stage_measurements = performance.solve_stages;
+
+	if (stage_measurements.size() != stages.size()) {
+		/* Follow the window of the other measurements, should it have been changed. */
+		stage_measurements.assign(stages.size(), augs::time_measurements(performance.logic.tracked.size()));
+
+		for (std::size_t s = 0; s < stages.size(); ++s) {
+			auto& title = stage_measurements[s].title;
+			title.clear();
+
+			for (const auto i : stages[s]) {
+				if (!title.empty()) {
+					title += " + ";
+				}
+
+				title += systems[i].name;
+			}
+		}
+	}
+
+	const auto num_additional_workers = step.get_settings().num_additional_workers;
+	const auto runner = standard_solve_task_runner { step, context };
+
+	thread_local std::vector<standard_solve_task> tasks;
+
+	double critical_path = 0.0;
+	double work = 0.0;
+
+	for (std::size_t s = 0; s < stages.size(); ++s) {
+		tasks.clear();
+
+		for (const auto i : stages[s]) {
+			tasks.push_back({ &systems[i] });
+		}
+
+		if (num_additional_workers == 0 || tasks.size() == 1) {
+			for (auto& task : tasks) {
+				runner(task);
+			}
+		}
+		else {
+			/* Thread local since several cosmoi might be solved at once, e.g. by a multi-arena server. */
+			thread_local augs::range_workers<standard_solve_task_runner> workers = num_additional_workers;
+			workers.resize_workers(num_additional_workers);
+			workers.process(runner, tasks);
+		}
+
+		double longest = 0.0;
+
+		for (const auto& task : tasks) {
+			longest = std::max(longest, task.secs);
+			work += task.secs;
+		}
+
+		stage_measurements[s].measure(longest);
+		critical_path += longest;
+	}
+
+	performance.solve_critical_path.measure(critical_path);
+	performance.solve_work.measure(work);
+}
+
 void standard_solve(const logic_step step) {
 	auto& cosm = step.get_cosmos();
 	auto& performance = cosm.profiler;
-	auto& global = cosm.get_global_solvable();
 
 #if STRESS_TEST_REINFERENCES
 	{
@@ -104,126 +400,11 @@ void standard_solve(const logic_step step) {
 
 	performance.entropy_length.measure(step.get_entropy().length());
 
-	sentience_system().cast_spells(step);
-
-	input_system().make_input_messages(step);
-
-	intent_contextualization_system().contextualize_crosshair_action_intents(step);
-	intent_contextualization_system().contextualize_movement_intents(step);
-
-	intent_contextualization_system().handle_use_button_presses(step);
-	intent_contextualization_system().advance_use_button(step);
-
-	{
-		auto scope = measure_scope(performance.movement_paths);
-		movement_path_system().advance_paths(step);
-	}
-
 	{
-		auto scope = measure_scope(performance.stateful_animations);
-		animation_system().advance_stateful_animations(step);
+		auto context = standard_solve_context { listener };
+		run_standard_solve_stages(step, context);
 	}
 
-	movement_system().set_movement_flags_from_input(step);
-	movement_system().apply_movement_forces(step);
-
-	crosshair_system().handle_crosshair_intents(step);
-	crosshair_system().update_base_offsets(step);
-	melee_system().initiate_and_update_moves(step);
-	sentience_system().rotate_towards_crosshairs_and_driven_vehicles(step);
-
-	gun_system().launch_shots_due_to_pressed_triggers(step);
-
-	car_system().set_steering_flags_from_intents(step);
-	car_system().apply_movement_forces(step);
-
-	melee_system().advance_thrown_melee_logic(step);
-
-	force_joint_system().apply_forces_towards_target_entities(step);
-	item_system().handle_throw_item_intents(step);
-	item_system().handle_reload_intents(step);
-	item_system().advance_reloading_contexts(step);
-	global.solve_item_mounting(step);
-	item_system().handle_wielding_requests(step);
-
-	{
-		auto scope = measure_scope(performance.explosives);
-
-		demolitions_system().detonate_fuses(step);
-		demolitions_system().advance_cascade_explosions(step);
-	}
-
-	{
-		listener.during_step = true;
-		physics_system().step_and_set_new_transforms(step);
-		listener.during_step = false;
-	}
-
-	physics_system().post_and_clear_accumulated_collision_messages(step);
-
-	trace_system().lengthen_sprites_of_traces(step);
-
-	crosshair_system().integrate_crosshair_recoils(step);
-
-	item_system().pick_up_touching_items(step);
-
-	{
-		auto scope = measure_scope(performance.missiles);
-
-		missile_system().ricochet_missiles(step);
-		missile_system().detonate_colliding_missiles(step);
-		missile_system().detonate_expired_missiles(step);
-	}
-
-	destruction_system().generate_damages_from_forceful_collisions(step);
-	destruction_system().apply_damages_and_split_fixtures(step);
-
-	{
-		auto scope = measure_scope(performance.sentiences);
-
-		sentience_system().process_special_results_of_health_events(step);
-		sentience_system().regenerate_values_and_advance_spell_logic(step);
-		sentience_system().apply_damage_and_generate_health_events(step);
-		sentience_system().cooldown_aimpunches(step);
-	}
-
-	driver_system().release_drivers_due_to_requests(step);
-	driver_system().assign_drivers_who_touch_wheels(step);
-	driver_system().release_drivers_due_to_ending_contact_with_wheel(step);
-
-	particles_existence_system().play_particles_from_events(step);
-	particles_existence_system().displace_streams(step);
-	sound_existence_system().play_sounds_from_events(step);
-
-	{
-		auto scope = measure_scope(performance.visibility);
-		auto visibility_raycasts_scope = cosm.measure_raycasts(performance.visibility_raycasts);
-
-		visibility_system(DEBUG_LOGIC_STEP_LINES).calc_visibility(step);
-	}
-
-	{
-		auto scope = measure_scope(performance.ai);
-		behaviour_tree_system().evaluate_trees(step);
-	}
-
-	{
-		auto pathfinding_raycasts_scope = cosm.measure_raycasts(performance.pathfinding_raycasts);
-
-#if TODO_PATHFINDING
-		auto scope = measure_scope(performance.pathfinding);
-		pathfinding_system().advance_pathfinding_sessions(step);
-#endif
-	}
-
-	{
-		auto& transfers = step.get_queue<item_slot_transfer_request>();
-		perform_transfers(transfers, step);
-	}
-
-	trace_system().destroy_outdated_traces(step);
-	remnant_system().shrink_and_destroy_remnants(step);
-
 	const auto queued_before_marking_num = step.get_queue<messages::queue_deletion>().size();
 	(void)queued_before_marking_num;
 
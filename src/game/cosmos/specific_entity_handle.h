@@ -36,6 +36,11 @@ protected:
 		return &subject;
 	}
 
+	template <class P>
+	auto find_real_index(const P&) const {
+		return iteration_index;
+	}
+
 public:
 	iterated_id_provider(
 		subject_reference subject,
@@ -103,6 +108,11 @@ protected:
 		return subject;
 	}
 
+	template <class P>
+	auto find_real_index(const P& pool) const {
+		return pool.index_of(stored_id.raw);
+	}
+
 public:
 	stored_id_provider(
 		const subject_pointer subject,
@@ -174,6 +184,11 @@ protected:
 		return &subject;
 	}
 
+	template <class P>
+	auto find_real_index(const P& pool) const {
+		return pool.index_of(stored_id.raw);
+	}
+
 public:
 	template <class T>
 	ref_stored_id_provider(
@@ -265,15 +280,27 @@ private:
 
 	template <class T>
 	maybe_const_ptr_t<is_const, T> find_component_ptr() const {
-		if constexpr(subject_type::template has<T>()) {
+		if constexpr(subject_type::template has_inline<T>()) {
 			ensure_alive();
 
 			return std::addressof(get_subject().template get<T>());
 		}
+		else if constexpr(subject_type::template has<T>()) {
+			ensure_alive();
+
+			auto& pool = owner.get_solvable({}).significant.template get_pool<entity_type>();
+			return std::addressof(pool.template get_column<T>()[this->find_real_index(pool)]);
+		}
 
 		return nullptr;
 	}
 
+	template <class F, class... C>
+	void for_each_column_component(F& callback, type_list<C...>) const {
+		(callback(std::as_const(*find_component_ptr<C>())), ...);
+		(void)callback;
+	}
+
 	template <bool>
 	friend class basic_entity_handle;
 
@@ -386,6 +413,19 @@ public:
 		return operator entity_id().operator unversioned_entity_id();
 	}
 
+	/* Bypasses the component synchronizers - for the domains that refresh the state on their own. */
+	template <class T>
+	auto& get_component(cosmos_solvable_access) const {
+		static_assert(subject_type::template has<T>());
+		return *find_component_ptr<T>();
+	}
+
+	template <class T>
+	const auto& get_component() const {
+		static_assert(subject_type::template has<T>());
+		return *find_component_ptr<T>();
+	}
+
 	template <class F>
 	void for_each_component(F&& callback) const {
 		ensure_alive();
@@ -393,8 +433,24 @@ public:
 
 		for_each_through_std_get(
 			immutable_subject.components, 
-			std::forward<F>(callback)
+			callback
 		);
+
+		for_each_column_component(callback, soa_components_of<entity_type>());
+	}
+
+	auto get_content() const {
+		ensure_alive();
+
+		const auto& meta = get_meta();
+		auto content = entity_content<entity_type>(meta.flavour_id, meta.when_born);
+
+		for_each_through_std_get(content.components, [&](auto& c) {
+			using C = remove_cref<decltype(c)>;
+			c = *find_component_ptr<C>();
+		});
+
+		return content;
 	}
 
 	/* For compatibility with the general handle */
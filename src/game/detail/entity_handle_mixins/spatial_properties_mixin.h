@@ -28,20 +28,19 @@ public:
 
 		if constexpr(E::is_specific) {
 			const auto& handle = *static_cast<const entity_handle_type*>(this);
-			auto& components = handle.get(keys...).components;
 
 			if constexpr(E::template has<components::rigid_body>()) {
 				if (!has_independent_transform()) {
 					return;
 				}
 
-				callback(std::get<components::rigid_body>(components).physics_transforms);
+				callback(handle.template get_component<components::rigid_body>(keys...).physics_transforms);
 			}
 			else if constexpr(E::template has<components::transform>()) {
-				callback(std::get<components::transform>(components));
+				callback(handle.template get_component<components::transform>(keys...));
 			}
 			else if constexpr(E::template has<components::position>()) {
-				callback(std::get<components::position>(components));
+				callback(handle.template get_component<components::position>(keys...));
 			}
 		}
 		else {
@@ -302,6 +301,13 @@ std::optional<transformr> spatial_properties_mixin<E>::find_logic_transform() co
 		return transformr(*pos, 0);
 	}	
 
+	/* Missiles advanced by swept rays have no body, so their transform is only kept in the component. */
+	if (handle.template has<components::missile>()) {
+		if (const auto rigid_body = handle.template find<components::rigid_body>()) {
+			return rigid_body.get_transform();
+		}
+	}
+
 	return std::nullopt;
 }
 
@@ -313,6 +319,12 @@ vec2 spatial_properties_mixin<E>::get_effective_velocity() const {
 		return owner.template get<components::rigid_body>().get_velocity();
 	}
 
+	if (handle && handle.template has<components::missile>()) {
+		if (const auto rigid_body = handle.template find<components::rigid_body>()) {
+			return rigid_body.get_velocity();
+		}
+	}
+
 	return {};
 }
 
@@ -0,0 +1,19 @@
+#pragma once
+
+/*
+	Homing missiles keep their bodies even when the missiles are advanced by swept rays,
+	as steering them needs the mass of the body.
+*/
+
+template <class E>
+bool is_like_swept_missile(const E& self) {
+	if (!self.get_cosmos().get_common_significant().missiles.swept_rays) {
+		return false;
+	}
+
+	if (const auto missile_def = self.template find<invariants::missile>()) {
+		return missile_def->homing_towards_hostile_strength == 0.f;
+	}
+
+	return false;
+}
@@ -48,8 +48,10 @@ void standard_explosion_input::instantiate(
 	const auto subject_if_any = cause.entity;
 
 	if (create_thunders_effect) {
+		/* Derived from the step, as many arenas might explode things concurrently. */
+		auto rng = step.get_cosmos().get_rng_for(subject_if_any);
+
 		for (int t = 0; t < 4; ++t) {
-			static randomization rng;
 			auto msg = messages::thunder_effect(predictability);
 			auto& th = msg.payload;
 
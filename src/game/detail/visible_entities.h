@@ -74,6 +74,10 @@ public:
 		return ::accumulate_sizes(per_layer);
 	}
 
+	bool empty(const render_layer l) const {
+		return per_layer[l].empty();
+	}
+
 	template <class C>
 	auto make_all() const {
 		C result;
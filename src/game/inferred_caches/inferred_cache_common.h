@@ -1,7 +1,284 @@
 #pragma once
-#include <unordered_map>
+#include <array>
+#include <memory>
+#include <vector>
+#include <utility>
+#include <optional>
+
+#include "augs/ensure.h"
 #include "game/cosmos/entity_id.h"
 
+/*
+	Maps entities to their inferred caches by the same indirection index that the entity pools use,
+	so that a lookup is just a couple of array accesses instead of hashing and walking a bucket list.
+
+	Slots are allocated in fixed-size pages that never move,
+	so - just like with std::unordered_map - inferring one entity never invalidates a reference to the cache of another.
+	Pages are only allocated for the ranges of indirection indices that were actually used,
+	which keeps the memory in check for sparse entity types.
+*/
+
 template <class cache_type>
-using inferred_cache_map = std::unordered_map<unversioned_entity_id, cache_type>;
+class inferred_cache_map {
+public:
+	using key_type = unversioned_entity_id;
+	using mapped_type = cache_type;
+	using value_type = std::pair<const key_type, mapped_type>;
+
+private:
+	static constexpr std::size_t page_size = 256;
+	static constexpr std::size_t num_types = entity_type_id::max_index_v;
+
+	using slot_type = std::optional<value_type>;
+	using page_type = std::array<slot_type, page_size>;
+	using pages_type = std::vector<std::unique_ptr<page_type>>;
+
+	std::array<pages_type, num_types> pages_per_type;
+	std::size_t count = 0;
+
+	static bool valid(const key_type& key) {
+		return key.is_set() && key.type_id.get_index() < num_types;
+	}
+
+	static auto page_index_of(const key_type& key) {
+		return static_cast<std::size_t>(key.raw.indirection_index) / page_size;
+	}
+
+	static auto slot_index_of(const key_type& key) {
+		return static_cast<std::size_t>(key.raw.indirection_index) % page_size;
+	}
+
+	const slot_type* find_slot(const key_type& key) const {
+		if (!valid(key)) {
+			return nullptr;
+		}
+
+		const auto& pages = pages_per_type[key.type_id.get_index()];
+		const auto page_index = page_index_of(key);
+
+		if (page_index < pages.size() && pages[page_index] != nullptr) {
+			return std::addressof((*pages[page_index])[slot_index_of(key)]);
+		}
+
+		return nullptr;
+	}
+
+	slot_type* find_slot(const key_type& key) {
+		return const_cast<slot_type*>(std::as_const(*this).find_slot(key));
+	}
+
+	slot_type& make_slot(const key_type& key) {
+		auto& pages = pages_per_type[key.type_id.get_index()];
+		const auto page_index = page_index_of(key);
+
+		if (page_index >= pages.size()) {
+			pages.resize(page_index + 1);
+		}
+
+		auto& page = pages[page_index];
+
+		if (page == nullptr) {
+			page = std::make_unique<page_type>();
+		}
+
+		return (*page)[slot_index_of(key)];
+	}
+
+	template <class S, class T>
+	class basic_iterator {
+		friend inferred_cache_map;
+
+		S* self = nullptr;
+		std::size_t type_index = 0;
+		std::size_t page_index = 0;
+		std::size_t slot_index = 0;
+
+		auto& current_slot() const {
+			return (*self->pages_per_type[type_index][page_index])[slot_index];
+		}
+
+		void skip_to_occupied() {
+			for (; type_index < num_types; ++type_index, page_index = 0, slot_index = 0) {
+				const auto& pages = self->pages_per_type[type_index];
+
+				for (; page_index < pages.size(); ++page_index, slot_index = 0) {
+					if (pages[page_index] == nullptr) {
+						continue;
+					}
+
+					const auto& page = *pages[page_index];
+
+					for (; slot_index < page_size; ++slot_index) {
+						if (page[slot_index].has_value()) {
+							return;
+						}
+					}
+				}
+			}
+		}
+
+		basic_iterator(S* self, const std::size_t type_index) : self(self), type_index(type_index) {
+			skip_to_occupied();
+		}
+
+	public:
+		T& operator*() const {
+			return *current_slot();
+		}
+
+		T* operator->() const {
+			return std::addressof(operator*());
+		}
+
+		basic_iterator& operator++() {
+			++slot_index;
+			skip_to_occupied();
+			return *this;
+		}
+
+		bool operator==(const basic_iterator& b) const {
+			return
+				type_index == b.type_index
+				&& page_index == b.page_index
+				&& slot_index == b.slot_index
+			;
+		}
+
+		bool operator!=(const basic_iterator& b) const {
+			return !operator==(b);
+		}
+	};
+
+public:
+	using iterator = basic_iterator<inferred_cache_map, value_type>;
+	using const_iterator = basic_iterator<const inferred_cache_map, const value_type>;
+
+	inferred_cache_map() = default;
+
+	inferred_cache_map(const inferred_cache_map& b) {
+		*this = b;
+	}
+
+	inferred_cache_map& operator=(const inferred_cache_map& b) {
+		if (this == std::addressof(b)) {
+			return *this;
+		}
+
+		clear();
+
+		for (const auto& it : b) {
+			try_emplace(it.first, it.second);
+		}
+
+		return *this;
+	}
+
+	inferred_cache_map(inferred_cache_map&&) = default;
+	inferred_cache_map& operator=(inferred_cache_map&&) = default;
+
+	template <class... Args>
+	std::pair<value_type*, bool> try_emplace(const key_type& key, Args&&... args) {
+		ensure(valid(key));
+
+		auto& slot = make_slot(key);
+
+		if (slot.has_value()) {
+			return { std::addressof(*slot), false };
+		}
+
+		slot.emplace(
+			std::piecewise_construct,
+			std::forward_as_tuple(key),
+			std::forward_as_tuple(std::forward<Args>(args)...)
+		);
+
+		++count;
+
+		return { std::addressof(*slot), true };
+	}
+
+	mapped_type& operator[](const key_type& key) {
+		return (*try_emplace(key).first).second;
+	}
+
+	mapped_type* find(const key_type& key) {
+		if (const auto slot = find_slot(key)) {
+			if (slot->has_value()) {
+				return std::addressof((*slot)->second);
+			}
+		}
+
+		return nullptr;
+	}
+
+	const mapped_type* find(const key_type& key) const {
+		if (const auto slot = find_slot(key)) {
+			if (slot->has_value()) {
+				return std::addressof((*slot)->second);
+			}
+		}
+
+		return nullptr;
+	}
+
+	std::size_t erase(const key_type& key) {
+		if (const auto slot = find_slot(key)) {
+			if (slot->has_value()) {
+				slot->reset();
+				--count;
+
+				return 1;
+			}
+		}
+
+		return 0;
+	}
+
+	std::size_t erase(const value_type* const entry) {
+		return erase(entry->first);
+	}
+
+	void clear() {
+		/* Keep the pages so that re-inference does not have to allocate them again. */
+
+		for (auto& pages : pages_per_type) {
+			for (auto& page : pages) {
+				if (page != nullptr) {
+					for (auto& slot : *page) {
+						slot.reset();
+					}
+				}
+			}
+		}
+
+		count = 0;
+	}
+
+	void reserve(const std::size_t) {
+		/* Pages are allocated lazily, per entity type. */
+	}
+
+	std::size_t size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	iterator begin() {
+		return { this, 0 };
+	}
+
+	iterator end() {
+		return { this, num_types };
+	}
+
+	const_iterator begin() const {
+		return { this, 0 };
+	}
 
+	const_iterator end() const {
+		return { this, num_types };
+	}
+};
@@ -0,0 +1,90 @@
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/inferred_caches/navigation_cache.hpp"
+
+void navigation_cache::unblock(cache& c) {
+	for (const auto& cell : c.blocked_cells) {
+		const auto it = blockers.find(cell);
+
+		if (it != blockers.end() && --it->second == 0) {
+			blockers.erase(it);
+		}
+	}
+
+	c.blocked_cells.clear();
+}
+
+void navigation_cache::destroy_cache_of(const const_entity_handle& handle) {
+	if (!baked) {
+		return;
+	}
+
+	const auto id = handle.get_id().to_unversioned();
+
+	if (const auto existing = per_entity_cache.find(id)) {
+		unblock(*existing);
+		per_entity_cache.erase(id);
+	}
+}
+
+void navigation_cache::bake_if_needed(const cosmos& cosm) {
+	if (baked) {
+		return;
+	}
+
+	baked = true;
+
+	cosm.for_each_entity<concerned_with>([this](const auto& handle) {
+		specific_infer_cache_for(handle);
+	});
+}
+
+void navigation_cache::infer_all(const cosmos&) {
+	/* Baked lazily, see bake_if_needed. */
+}
+
+void navigation_cache::infer_cache_for(const const_entity_handle& e) {
+	if (!baked) {
+		return;
+	}
+
+	using navigation_entities = entity_types_passing<concerned_with>;
+
+	e.conditional_dispatch<navigation_entities>([this](const auto& handle) {
+		specific_infer_cache_for(handle);
+	});
+}
+
+bool navigation_cache::is_line_walkable(vec2i from, const vec2i to) const {
+	/* Bresenham's walk through every cell on the line. */
+
+	const auto dx = std::abs(to.x - from.x);
+	const auto dy = -std::abs(to.y - from.y);
+	const auto sx = from.x < to.x ? 1 : -1;
+	const auto sy = from.y < to.y ? 1 : -1;
+
+	auto err = dx + dy;
+
+	while (true) {
+		if (!is_walkable(from)) {
+			return false;
+		}
+
+		if (from == to) {
+			return true;
+		}
+
+		const auto e2 = 2 * err;
+
+		if (e2 >= dy) {
+			err += dy;
+			from.x += sx;
+		}
+
+		if (e2 <= dx) {
+			err += dx;
+			from.y += sy;
+		}
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+
+#include "augs/math/vec2.h"
+#include "game/inferred_caches/inferred_cache_common.h"
+#include "game/cosmos/entity_handle_declaration.h"
+#include "game/organization/all_entity_types_declaration.h"
+
+class cosmos;
+
+/*
+	Navigation grid baked from the static walls of the map.
+
+	Every static plain_sprited_body marks the cells it covers (inflated by the clearance of a bot) as blocked.
+	Cells keep a count of walls covering them, so a destroyed wall only unmarks its own cells
+	and never has to rebuild the whole grid.
+
+	The grid is only baked once pathfinding_system first needs it.
+	Until then the cache stays empty and ignores walls being inferred or destroyed,
+	so cosmoses without any pathfinding entity - and every clone of them - never pay for it.
+*/
+
+class navigation_cache {
+	struct cache {
+		std::vector<vec2i> blocked_cells;
+	};
+
+	inferred_cache_map<cache> per_entity_cache;
+	std::unordered_map<vec2i, unsigned short> blockers;
+	bool baked = false;
+
+	void unblock(cache&);
+
+public:
+	static constexpr real32 cell_size = 32.f;
+	static constexpr real32 clearance = 24.f;
+
+	template <class E>
+	struct concerned_with {
+		static constexpr bool value = std::is_same_v<E, plain_sprited_body>;
+	};
+
+	static vec2i cell_of(const vec2 pos) {
+		return {
+			static_cast<int>(repro::floor(pos.x / cell_size)),
+			static_cast<int>(repro::floor(pos.y / cell_size))
+		};
+	}
+
+	static vec2 center_of(const vec2i cell) {
+		return (vec2(cell) + vec2::square(0.5f)) * cell_size;
+	}
+
+	bool is_walkable(const vec2i cell) const {
+		return blockers.find(cell) == blockers.end();
+	}
+
+	bool is_line_walkable(vec2i from, vec2i to) const;
+
+	std::size_t get_num_blocked_cells() const {
+		return blockers.size();
+	}
+
+	bool is_baked() const {
+		return baked;
+	}
+
+	void bake_if_needed(const cosmos&);
+
+	void infer_all(const cosmos&);
+
+	template <class E>
+	void specific_infer_cache_for(const E&);
+
+	void infer_cache_for(const const_entity_handle&);
+	void destroy_cache_of(const const_entity_handle&);
+};
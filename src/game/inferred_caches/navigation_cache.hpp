@@ -0,0 +1,50 @@
+#pragma once
+#include "game/inferred_caches/navigation_cache.h"
+#include "game/components/rigid_body_component.h"
+#include "game/components/fixtures_component.h"
+
+template <class E>
+void navigation_cache::specific_infer_cache_for(const E& handle) {
+	const auto id = handle.get_id().to_unversioned();
+
+	if (const auto existing = per_entity_cache.find(id)) {
+		unblock(*existing);
+		per_entity_cache.erase(id);
+	}
+
+	if (handle.template get<invariants::rigid_body>().body_type != rigid_body_type::STATIC) {
+		return;
+	}
+
+	if (handle.template get<invariants::fixtures>().sensor) {
+		return;
+	}
+
+	const auto transform = handle.find_logic_transform();
+	const auto aabb = handle.find_aabb();
+
+	if (transform == std::nullopt || aabb == std::nullopt) {
+		return;
+	}
+
+	const auto reach = handle.get_logical_size() / 2 + vec2::square(clearance);
+
+	const auto first = cell_of(vec2(aabb->l, aabb->t) - vec2::square(clearance));
+	const auto last = cell_of(vec2(aabb->r, aabb->b) + vec2::square(clearance));
+
+	auto& new_cache = (*per_entity_cache.try_emplace(id).first).second;
+
+	for (int y = first.y; y <= last.y; ++y) {
+		for (int x = first.x; x <= last.x; ++x) {
+			const auto cell = vec2i(x, y);
+
+			/* Test the center of the cell against the wall's rectangle, inflated by the clearance. */
+			const auto local = (center_of(cell) - transform->pos).rotate(-transform->rotation);
+
+			if (repro::fabs(local.x) <= reach.x && repro::fabs(local.y) <= reach.y) {
+				new_cache.blocked_cells.push_back(cell);
+				++blockers[cell];
+			}
+		}
+	}
+}
@@ -203,10 +203,232 @@ physics_world_cache::physics_world_cache(const physics_world_cache& b) : physics
 	*this = b;
 }
 
+/*
+	Almost everything that the world links to lives in the blocks of its b2BlockAllocator,
+	so the allocator can be cloned chunk by chunk and every pointer moved over by its offset within the chunk.
+	The pointers still have to be found by walking the world, but no lookup tables are built.
+
+	Blocks larger than b2_maxBlockSize are allocated separately and can not be relocated.
+	Bodies, fixtures, shapes, contacts and joints never are that large,
+	but the proxies of a chain shape with many edges might be.
+	If the allocator holds any such block, the world is migrated block by block instead.
+*/
+
+static_assert(sizeof(b2Body) <= b2_maxBlockSize);
+static_assert(sizeof(b2Fixture) <= b2_maxBlockSize);
+static_assert(sizeof(b2PolygonShape) <= b2_maxBlockSize);
+static_assert(sizeof(b2CircleShape) <= b2_maxBlockSize);
+static_assert(sizeof(b2Contact) <= b2_maxBlockSize);
+static_assert(sizeof(b2MotorJoint) <= b2_maxBlockSize);
+
 physics_world_cache& physics_world_cache::operator=(const physics_world_cache& from_world) {
-	ray_cast_counter = from_world.ray_cast_counter;
+	ray_cast_counter = from_world.ray_cast_counter.load();
 	accumulated_messages = from_world.accumulated_messages;
 
+	/* 
+		The relocation overwrites the previous contents in place,
+		so the target must not own any large block either, or it would leak.
+	*/
+
+	const bool relocatable = 
+		from_world.b2world->m_blockAllocator.GetLargeBlockCount() == 0
+		&& b2world->m_blockAllocator.GetLargeBlockCount() == 0
+	;
+
+	if (relocatable) {
+		relocate_from(from_world);
+	}
+	else {
+		migrate_from(from_world);
+	}
+
+	return *this;
+}
+
+void physics_world_cache::relocate_from(const physics_world_cache& from_world) {
+	b2World& migrated_b2World = *b2world.get();
+	const b2World& source_b2World = *from_world.b2world.get();
+
+	/*
+		The previous contents are simply overwritten, so that the chunks of the allocator can be reused.
+		Only chain shapes own memory outside of the allocator.
+	*/
+
+	for (b2Body* b = migrated_b2World.m_bodyList; b; b = b->m_next) {
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next) {
+			if (f->m_shape->GetType() == b2Shape::e_chain) {
+				static_cast<b2ChainShape*>(f->m_shape)->~b2ChainShape();
+			}
+		}
+	}
+
+#if DEBUG_PHYSICS_SYSTEM_COPY
+	ensure_eq(0, source_b2World.m_stackAllocator.m_entryCount);
+	ensure_eq(0, source_b2World.m_stackAllocator.m_index);
+#endif
+
+	// do the initial trivial copy of all fields,
+	// we will relocate all pointers shortly
+	migrated_b2World = source_b2World;
+
+	{
+#if DEBUG_PHYSICS_SYSTEM_COPY
+		ensure_eq(0, migrated_b2World.m_stackAllocator.m_entryCount);
+		ensure_eq(0, migrated_b2World.m_stackAllocator.m_index);
+#endif
+
+		b2StackEntry null_entry;
+		null_entry.data = nullptr;
+
+		auto& entries = migrated_b2World.m_stackAllocator.m_entries;
+		std::fill(std::begin(entries), std::end(entries), null_entry);
+	}
+
+	/*
+	   	b2BlockAllocator has a null operator=, 
+		so the migrated_b2World preserves its own allocator even after the above copy. 
+	*/
+
+	b2BlockAllocator& migrated_allocator = migrated_b2World.m_blockAllocator;
+	migrated_allocator.CloneFrom(source_b2World.m_blockAllocator);
+
+	// reset the allocator pointer to the new one
+	migrated_b2World.m_contactManager.m_allocator = &migrated_allocator;
+
+	auto relocate = [&migrated_allocator](auto*& p) {
+		p = migrated_allocator.Relocate(p);
+	};
+
+	// contacts and their edges
+
+	relocate(migrated_b2World.m_contactManager.m_contactList);
+
+	for (b2Contact* c = migrated_b2World.m_contactManager.m_contactList; c; c = c->m_next) {
+		relocate(c->m_prev);
+		relocate(c->m_next);
+		relocate(c->m_fixtureA);
+		relocate(c->m_fixtureB);
+
+		for (auto* node : { &c->m_nodeA, &c->m_nodeB }) {
+			node->contact = c;
+			relocate(node->other);
+			relocate(node->prev);
+			relocate(node->next);
+		}
+	}
+
+	// joints and their edges
+
+	relocate(migrated_b2World.m_jointList);
+
+	for (b2Joint* j = migrated_b2World.m_jointList; j; j = j->m_next) {
+		relocate(j->m_prev);
+		relocate(j->m_next);
+		relocate(j->m_bodyA);
+		relocate(j->m_bodyB);
+
+		for (auto* edge : { &j->m_edgeA, &j->m_edgeB }) {
+			edge->joint = j;
+			relocate(edge->other);
+			relocate(edge->prev);
+			relocate(edge->next);
+		}
+	}
+
+	// bodies and fixtures
+
+	auto& proxy_tree = migrated_b2World.m_contactManager.m_broadPhase.m_tree;
+
+	relocate(migrated_b2World.m_bodyList);
+
+	for (b2Body* b = migrated_b2World.m_bodyList; b; b = b->m_next) {
+		relocate(b->m_prev);
+		relocate(b->m_next);
+		relocate(b->m_ownerFrictionGround);
+		relocate(b->m_fixtureList);
+		relocate(b->m_contactList);
+		relocate(b->m_jointList);
+
+		b->m_world = &migrated_b2World;
+
+		for (b2Fixture* f = b->m_fixtureList; f; f = f->m_next) {
+			f->m_body = b;
+
+			relocate(f->m_next);
+			relocate(f->m_shape);
+			relocate(f->m_proxies);
+
+			if (f->m_shape->GetType() == b2Shape::e_chain) {
+				auto& chain = *static_cast<b2ChainShape*>(f->m_shape);
+				const auto source_vertices = chain.m_vertices;
+
+				chain.m_vertices = static_cast<b2Vec2*>(b2Alloc(chain.m_count * sizeof(b2Vec2)));
+				std::memcpy(chain.m_vertices, source_vertices, chain.m_count * sizeof(b2Vec2));
+			}
+
+			for (int32 i = 0; i < f->m_proxyCount; ++i) {
+				f->m_proxies[i].fixture = f;
+
+				void*& ud = proxy_tree.m_nodes[f->m_proxies[i].proxyId].userData;
+				ud = f->m_proxies + i;
+			}
+		}
+	}
+
+	colliders_caches.clear();
+	rigid_body_caches.clear();
+
+	colliders_caches.reserve(from_world.colliders_caches.size());
+	rigid_body_caches.reserve(from_world.rigid_body_caches.size());
+
+	for (const auto& it : from_world.colliders_caches) {
+		auto& migrated_cache = colliders_caches[it.first];
+
+		migrated_cache = it.second;
+		migrated_cache.constructed_fixtures.clear();
+
+		for (const auto& f : it.second.constructed_fixtures) {
+			migrated_cache.constructed_fixtures.emplace_back(migrated_allocator.Relocate(f.get()));
+		}
+	}
+	
+	for (const auto& it : from_world.rigid_body_caches) {
+		const auto b_body = it.second.body.get();
+
+		auto& migrated_cache = rigid_body_caches[it.first];
+		static_assert(sizeof(migrated_cache) == sizeof(augs::propagate_const<b2Body*>));
+
+#if WHEN_MORE_FIELDS_ADDED
+		migrated_cache = it.second;
+#endif
+
+		migrated_cache.body = migrated_allocator.Relocate(b_body);
+	}
+
+#if TODO
+	joint_caches.clear();
+	joint_caches.reserve(from_world.joint_caches.size());
+
+	for (auto& it : joint_caches) {
+		const auto b_joint = from_world.joint_caches[it.first].joint.get();
+
+		if (b_joint) {
+			joint_caches[i].joint = reinterpret_cast<b2Joint*>(pointer_migrations.at(reinterpret_cast<const void*>(b_joint)));
+		}
+	}
+#endif
+
+#if DEBUG_PHYSICS_SYSTEM_COPY
+	// ensure that all allocations have been migrated
+
+	ensure_eq(
+		migrated_allocator.m_numAllocatedObjects, 
+		source_b2World.m_blockAllocator.m_numAllocatedObjects
+	);
+#endif
+}
+
+void physics_world_cache::migrate_from(const physics_world_cache& from_world) {
 	b2World& migrated_b2World = *b2world.get();
 	migrated_b2World.~b2World();
 	new (&migrated_b2World) b2World(b2Vec2(0.f, 0.f));
@@ -506,8 +728,9 @@ physics_world_cache& physics_world_cache::operator=(const physics_world_cache& f
 #endif
 				f->m_proxies[i].fixture = f;
 				
+				/* Only the first proxy of a shape with many children is in the map. */
 				void*& ud = proxy_tree.m_nodes[f->m_proxies[i].proxyId].userData;
-				ud = pointer_migrations.at(ud);
+				ud = f->m_proxies + i;
 			}
 		}
 	}
@@ -573,6 +796,131 @@ physics_world_cache& physics_world_cache::operator=(const physics_world_cache& f
 		source_b2World.m_blockAllocator.m_numAllocatedObjects
 	);
 #endif
+}
 
-	return *this;
+#if BUILD_UNIT_TESTS
+#include <Catch/single_include/catch2/catch.hpp>
+#include "3rdparty/crc32/crc32.h"
+
+namespace {
+	b2BodyDef body_def_at(const b2Vec2 pos) {
+		b2BodyDef def;
+
+		def.transform.p = pos;
+		def.transform.q.SetIdentity();
+
+		def.sweep.localCenter.SetZero();
+		def.sweep.c0 = def.sweep.c = pos;
+		def.sweep.a0 = def.sweep.a = 0.f;
+		def.sweep.alpha0 = 0.f;
+
+		return def;
+	}
+
+	/* Boxes thrown at a static chain, so that the steps keep making and breaking contacts with its edges. */
+
+	void populate_with_chain(b2World& world, const int num_chain_vertices) {
+		std::vector<b2Vec2> vertices;
+
+		for (int i = 0; i < num_chain_vertices; ++i) {
+			vertices.emplace_back(static_cast<float32>(i) - num_chain_vertices / 2.f, (i % 2) * 0.5f);
+		}
+
+		const auto ground_def = body_def_at(b2Vec2(0.f, 0.f));
+		auto* const ground = world.CreateBody(&ground_def);
+
+		b2ChainShape chain;
+		chain.CreateChain(vertices.data(), static_cast<int32>(vertices.size()));
+		ground->CreateFixture(&chain, 0.f);
+
+		for (int i = 0; i < 10; ++i) {
+			auto def = body_def_at(b2Vec2(static_cast<float32>(i % 5) - 2.5f, 2.f + static_cast<float32>(i / 5) * 1.5f));
+			def.type = b2_dynamicBody;
+			def.linearVelocity.Set(static_cast<float32>(i % 3) - 1.f, -5.f);
+			def.angularVelocity = static_cast<float32>(i) * 0.3f;
+
+			b2PolygonShape box;
+			box.SetAsBox(0.3f, 0.2f);
+
+			world.CreateBody(&def)->CreateFixture(&box, 1.f);
+		}
+	}
+
+	uint32_t hash_bodies_of(const b2World& world) {
+		std::vector<float32> state;
+
+		for (const b2Body* b = world.GetBodyList(); b; b = b->GetNext()) {
+			const auto& xf = b->GetTransform();
+			const auto& vel = b->GetLinearVelocity();
+
+			state.insert(state.end(), { xf.p.x, xf.p.y, b->GetAngle(), vel.x, vel.y, b->GetAngularVelocity() });
+		}
+
+		return crc32buf(reinterpret_cast<char*>(state.data()), state.size() * sizeof(float32));
+	}
+
+	void step(physics_world_cache& cache, const int num_steps) {
+		for (int i = 0; i < num_steps; ++i) {
+			cache.get_b2world().Step(1 / 60.f, 8, 3);
+		}
+	}
 }
+
+TEST_CASE("PhysicsWorldCache RelocatedAndMigratedCloneStepAlike") {
+	const auto num_steps = 200;
+
+	/* The proxies of a chain with 7 edges fit in a block, the proxies of one with 59 edges do not. */
+	const auto small_chain = 8;
+	const auto large_chain = 60;
+
+	SECTION("Chain within the blocks") {
+		physics_world_cache source;
+		populate_with_chain(source.get_b2world(), small_chain);
+
+		REQUIRE(source.get_b2world().m_blockAllocator.GetLargeBlockCount() == 0);
+
+		/* Neither allocator holds a large block, so the world is relocated. */
+		physics_world_cache relocated;
+		relocated = source;
+
+		/* A large block in the target forces a migration from the very same source. */
+		physics_world_cache migrated;
+		populate_with_chain(migrated.get_b2world(), large_chain);
+
+		REQUIRE(migrated.get_b2world().m_blockAllocator.GetLargeBlockCount() > 0);
+
+		migrated = source;
+
+		REQUIRE(migrated.get_b2world().m_blockAllocator.GetLargeBlockCount() == 0);
+
+		step(source, num_steps);
+		step(relocated, num_steps);
+		step(migrated, num_steps);
+
+		const auto expected = hash_bodies_of(source.get_b2world());
+
+		REQUIRE(hash_bodies_of(relocated.get_b2world()) == expected);
+		REQUIRE(hash_bodies_of(migrated.get_b2world()) == expected);
+	}
+
+	SECTION("Chain outside the blocks") {
+		/* Two equal worlds, one stepped as is and one stepped after being migrated. */
+
+		physics_world_cache reference;
+		populate_with_chain(reference.get_b2world(), large_chain);
+
+		physics_world_cache source;
+		populate_with_chain(source.get_b2world(), large_chain);
+
+		REQUIRE(source.get_b2world().m_blockAllocator.GetLargeBlockCount() > 0);
+
+		physics_world_cache migrated;
+		migrated = source;
+
+		step(reference, num_steps);
+		step(migrated, num_steps);
+
+		REQUIRE(hash_bodies_of(migrated.get_b2world()) == hash_bodies_of(reference.get_b2world()));
+	}
+}
+#endif
@@ -1,4 +1,5 @@
 #pragma once
+#include <atomic>
 #include "3rdparty/Box2D/Box2D.h"
 
 #include "augs/misc/constant_size_vector.h"
@@ -73,6 +74,9 @@ class physics_world_cache {
 		const colliders_connection&
 	);
 
+	void relocate_from(const physics_world_cache&);
+	void migrate_from(const physics_world_cache&);
+
 public:
 	template <class E>
 	struct concerned_with {
@@ -172,7 +176,8 @@ public:
 	void step_and_set_new_transforms(const logic_step);
 	void post_and_clear_accumulated_collision_messages(const logic_step);
 
-	mutable std::size_t ray_cast_counter = 0u;
+	/* Atomic, because visibility can be calculated on many threads at once. */
+	mutable std::atomic<std::size_t> ray_cast_counter = 0u;
 
 	rigid_body_cache* find_rigid_body_cache(const entity_id);
 	colliders_cache* find_colliders_cache(const entity_id);
@@ -5,6 +5,7 @@
 
 #include "game/detail/explosive/like_explosive.h"
 #include "game/detail/melee/like_melee.h"
+#include "game/detail/missile/like_swept_missile.h"
 #include "game/detail/physics/infer_damping.hpp"
 #include "game/detail/entity_handle_mixins/calc_connection.hpp"
 
@@ -104,6 +105,11 @@ void physics_world_cache::specific_infer_cache_for(const E& typed_handle) {
 
 template <class E>
 void physics_world_cache::specific_infer_rigid_body_from_scratch(const E& handle) {
+	if (::is_like_swept_missile(handle)) {
+		/* Advanced by the missile system instead. */
+		return;
+	}
+
 	const auto it = rigid_body_caches.try_emplace(unversioned_entity_id(handle));
 	auto& cache = (*it.first).second;
 
@@ -163,6 +169,10 @@ void physics_world_cache::specific_infer_rigid_body_from_scratch(const E& handle
 
 template <class E>
 void physics_world_cache::specific_infer_rigid_body(const E& handle) {
+	if (::is_like_swept_missile(handle)) {
+		return;
+	}
+
 	const auto it = rigid_body_caches.try_emplace(unversioned_entity_id(handle));
 	auto& cache = (*it.first).second;
 
@@ -235,6 +245,11 @@ template <class E>
 void physics_world_cache::specific_infer_colliders_from_scratch(const E& handle, const colliders_connection& connection) {
 	const auto& cosm = handle.get_cosmos();
 
+	if (::is_like_swept_missile(handle)) {
+		/* Advanced by the missile system instead. */
+		return;
+	}
+
 	const auto it = colliders_caches.try_emplace(handle.get_id().to_unversioned());
 
 	auto& cache = (*it.first).second;
@@ -447,6 +462,10 @@ void physics_world_cache::specific_infer_colliders_from_scratch(const E& handle,
 
 template <class E>
 void physics_world_cache::specific_infer_colliders(const E& handle) {
+	if (::is_like_swept_missile(handle)) {
+		return;
+	}
+
 	std::optional<colliders_connection> calculated_connection;
 
 	auto get_calculated_connection = [&](){
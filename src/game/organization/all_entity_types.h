@@ -44,6 +44,12 @@ struct controlled_character {
 
 		components::interpolation
 	>;
+
+	using soa_components = type_list<
+		::components::rigid_body,
+		::components::sentience,
+		::components::interpolation
+	>;
 };
 
 /* E.g. a crate, a wall */
@@ -68,6 +74,11 @@ struct plain_sprited_body {
 		components::rigid_body,
 		components::interpolation
 	>;
+
+	using soa_components = type_list<
+		::components::rigid_body,
+		::components::interpolation
+	>;
 };
 
 /* E.g. an AK or a pistol */
@@ -261,6 +272,11 @@ struct plain_missile {
 
 		components::interpolation
 	>;
+
+	using soa_components = type_list<
+		::components::rigid_body,
+		::components::interpolation
+	>;
 };
 
 struct finishing_trace {
@@ -350,6 +366,11 @@ struct remnant_body {
 		components::interpolation,
 		components::remnant
 	>;
+
+	using soa_components = type_list<
+		::components::rigid_body,
+		::components::interpolation
+	>;
 };
 
 struct sound_decoration {
@@ -1,5 +1,8 @@
+#include <tuple>
+
 #include "missile_system.h"
 #include "augs/math/steering.h"
+#include "augs/templates/algorithm_templates.h"
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/entity_id.h"
 #include "game/cosmos/for_each_entity.h"
@@ -29,6 +32,9 @@
 #include "game/detail/entity_handle_mixins/get_owning_transfer_capability.hpp"
 
 #include "game/detail/physics/physics_scripts.h"
+#include "game/detail/physics/physics_queries.h"
+#include "game/detail/physics/infer_damping.hpp"
+#include "game/inferred_caches/physics_world_cache.h"
 
 #include "game/assets/ids/asset_ids.h"
 
@@ -61,9 +67,218 @@ void RIC_LOG(Args&&... args) {
 #include "game/detail/missile/missile_utils.h"
 #include "game/detail/missile/missile_collision.h"
 #include "game/detail/missile/missile_ricochet.h"
+#include "game/detail/missile/like_swept_missile.h"
 
 using namespace augs;
 
+struct missile_sweep_hit {
+	const b2Fixture* fixture = nullptr;
+	vec2 point;
+	vec2 normal;
+	real32 fraction = 0.f;
+};
+
+struct missile_sweep_input : public b2RayCastCallback {
+	b2Filter filter;
+	std::vector<missile_sweep_hit> hits;
+
+	bool ShouldRaycast(b2Fixture* const fixture) override {
+		return !fixture->IsSensor() && b2ContactFilter::ShouldCollide(&filter, &fixture->GetFilterData());
+	}
+
+	float32 ReportFixture(
+		b2Fixture* const fixture, 
+		const b2Vec2& point,
+		const b2Vec2& normal, 
+		const float32 fraction
+	) override {
+		hits.push_back({ fixture, vec2(point), vec2(normal), fraction });
+		return 1.f;
+	}
+};
+
+void missile_system::advance_swept_missiles(const logic_step step) {
+	auto& cosm = step.get_cosmos();
+
+	if (!cosm.get_common_significant().missiles.swept_rays) {
+		return;
+	}
+
+	const auto& physics = cosm.get_solvable_inferred().physics;
+	const auto si = cosm.get_si();
+	const auto dt = step.get_delta().in_seconds();
+
+	missile_sweep_input sweep;
+
+	/*
+		The order in which the broadphase reports the fixtures must not matter,
+		so the hits are sorted by their distance along the ray and then by their identity.
+	*/
+
+	auto hit_order = [](const missile_sweep_hit& h) {
+		const auto id = h.fixture->GetUserData();
+		return std::make_tuple(h.fraction, id.type_id.get_index(), id.raw.indirection_index, h.fixture->index_in_component);
+	};
+
+	cosm.for_each_having<components::missile>(
+		[&](const auto typed_missile) {
+			if (!::is_like_swept_missile(typed_missile)) {
+				return;
+			}
+
+			auto& missile = typed_missile.template get<components::missile>();
+
+			if (missile.damage_charges_before_destruction == 0) {
+				return;
+			}
+
+			const auto& missile_def = typed_missile.template get<invariants::missile>();
+			const auto& body_def = typed_missile.template get<invariants::rigid_body>();
+			const auto& fixtures_def = typed_missile.template get<invariants::fixtures>();
+			const auto rigid_body = typed_missile.template get<components::rigid_body>();
+
+			/* Same damping as Box2D would apply to the body. */
+
+			auto vel = rigid_body.get_velocity();
+
+			{
+				const auto damping = ::calc_damping_mults(typed_missile, body_def);
+
+				vel *= 1.f / (1.f + dt * damping.linear);
+
+				if (body_def.angled_damping) {
+					vel.x *= 1.f / (1.f + dt * damping.linear_axis_aligned.x);
+					vel.y *= 1.f / (1.f + dt * damping.linear_axis_aligned.y);
+				}
+			}
+
+			const auto rotation = rigid_body.get_degrees();
+			const auto from = rigid_body.get_position();
+			const auto to = from + vel * dt;
+
+			auto move_to = [&](const vec2 where) {
+				rigid_body.set_velocity(vel);
+				rigid_body.set_transform(transformr(where, rotation));
+			};
+
+			sweep.filter = fixtures_def.filter;
+			sweep.hits.clear();
+
+			if (!missile.when_fired.was_set()) {
+				/*
+					Rays ignore the fixtures that they start in, so a missile spawned inside one would pass right through it.
+					A body would begin a contact there, so the first sweep also hits whatever contains the starting point.
+				*/
+
+				missile.when_fired = cosm.get_timestamp();
+
+				const auto from_meters = b2Vec2(si.get_meters(from));
+				const auto facing = vel.is_nonzero() ? vec2(vel).normalize() : vec2::from_degrees(rotation);
+
+				b2AABB point_aabb;
+				point_aabb.lowerBound = from_meters;
+				point_aabb.upperBound = from_meters;
+
+				for_each_in_aabb_meters(
+					*physics.b2world,
+					point_aabb,
+					sweep.filter,
+					[&](const b2Fixture& fixture) {
+						if (!fixture.IsSensor() && fixture.TestPoint(from_meters)) {
+							sweep.hits.push_back({ std::addressof(fixture), vec2(from_meters), -facing, 0.f });
+						}
+
+						return callback_result::CONTINUE;
+					}
+				);
+			}
+
+			if ((to - from).is_nonzero()) {
+				physics.ray_cast_counter.fetch_add(1, std::memory_order_relaxed);
+				physics.b2world->RayCast(&sweep, b2Vec2(si.get_meters(from)), b2Vec2(si.get_meters(to)));
+			}
+
+			sort_range(sweep.hits, [&](const auto& a, const auto& b) { return hit_order(a) < hit_order(b); });
+
+			for (const auto& hit : sweep.hits) {
+				const auto surface_handle = cosm[hit.fixture->GetUserData()];
+				const auto info = missile_surface_info(typed_missile, surface_handle);
+
+				if (info.should_ignore_altogether()) {
+					continue;
+				}
+
+				const auto point = si.get_pixels(hit.point);
+				const auto& normal = hit.normal;
+
+				/* A ricochet starts from where the missile has hit. */
+				move_to(point);
+
+				const auto ricocheted_before = missile.when_last_ricocheted;
+
+				::ricochet_missile_against_surface(
+					step,
+
+					typed_missile, 
+					surface_handle,
+
+					normal,
+					vel,
+					point
+				);
+
+				if (!(missile.when_last_ricocheted == ricocheted_before)) {
+					return;
+				}
+
+				b2Fixture_indices indices;
+				indices.subject = physics.get_index_in_component(*hit.fixture, surface_handle);
+
+				if (const auto result = collide_missile_against_surface(
+					step,
+
+					typed_missile, 
+					surface_handle,
+
+					missile_def,
+					missile,
+
+					missile_collision_type::CONTACT_START,
+
+					info,
+
+					indices,
+
+					normal,
+					vel,
+					point
+				)) {
+					missile.saved_point_of_impact_before_death = result->transform_of_impact;
+					missile.damage_charges_before_destruction = result->new_charges_value;
+				}
+
+				if (missile.damage_charges_before_destruction == 0) {
+					return;
+				}
+
+				/* The contact listener lets missiles through these without any impulse. */
+				const bool flies_through = info.ignore_standard_impulse() || surface_handle.template has<components::sentience>();
+
+				if (!flies_through) {
+					/* Bounce off like a body would. */
+					const auto restitution = std::max(fixtures_def.restitution, surface_handle.template get<invariants::fixtures>().restitution);
+
+					vel -= normal * vel.dot(normal) * (1.f + restitution);
+					move_to(point);
+					return;
+				}
+			}
+
+			move_to(to);
+		}
+	);
+}
+
 void missile_system::ricochet_missiles(const logic_step step) {
 	auto& cosm = step.get_cosmos();
 	const auto& events = step.get_queue<messages::collision_message>();
@@ -406,4 +621,75 @@ void missile_system::detonate_expired_missiles(const logic_step step) {
 			}
 		}
 	);
-}
\ No newline at end of file
+}
+
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+
+#include "augs/misc/lua/lua_utils.h"
+#include "game/cosmos/change_common_significant.hpp"
+#include "game/cosmos/solvers/standard_solver.h"
+#include "game/modes/test_mode.h"
+#include "application/intercosm.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+
+TEST_CASE("SweptMissiles SpawnedInsideFixture") {
+	const auto entropy = cosmic_entropy();
+	const auto settings = solve_settings();
+
+	/* A missile fired from within a character must hit it, even though a ray ignores the fixture it starts in. */
+
+	auto is_consumed = [&](const bool swept_rays) {
+		auto lua = augs::create_lua_state();
+
+		/* Intercosm is too big for the stack. */
+		const auto scene = std::make_unique<intercosm>();
+		test_mode_ruleset ruleset;
+
+		scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+		auto& cosm = scene->world;
+
+		cosm.change_common_significant([&](cosmos_common_significant& common) {
+			common.missiles.swept_rays = swept_rays;
+			return changer_callback_result::REFRESH;
+		});
+
+		entity_id victim;
+
+		cosm.for_each_having<components::sentience>(
+			[&](const auto sentient) {
+				if (!victim.is_set()) {
+					victim = sentient.get_id();
+				}
+			}
+		);
+
+		REQUIRE(victim.is_set());
+
+		entity_id round_id;
+
+		create_test_scene_entity(cosm, test_plain_missiles::CYAN_ROUND, [&](const auto round, auto&&...) {
+			round.set_logic_transform(transformr(cosm[victim].get_logic_transform().pos, 0.f));
+			round.template get<components::rigid_body>().set_velocity(vec2(1.f, 0.f));
+
+			round_id = round.get_id();
+		});
+
+		REQUIRE(cosm[round_id].alive());
+
+		for (int i = 0; i < 5; ++i) {
+			standard_solver()(
+				logic_step_input { cosm, entropy, settings },
+				solver_callbacks()
+			);
+		}
+
+		return cosm[round_id].dead();
+	};
+
+	REQUIRE(is_consumed(false));
+	REQUIRE(is_consumed(true));
+}
+#endif
@@ -6,6 +6,7 @@ class cosmos;
 class missile_system {
 public:
 
+	void advance_swept_missiles(const logic_step step);
 	void ricochet_missiles(const logic_step step);
 	void detonate_colliding_missiles(const logic_step step);
 	void detonate_expired_missiles(const logic_step step);
@@ -1,3 +1,6 @@
+#include <cmath>
+#include <vector>
+
 #include "augs/misc/randomization.h"
 #include "augs/math/steering.h"
 #include "augs/math/make_rect_points.h"
@@ -10,11 +13,126 @@
 #include "game/messages/interpolation_correction_request.h"
 #include "game/messages/queue_deletion.h"
 #include "game/messages/will_soon_be_deleted.h"
-#include "game/detail/visible_entities.h"
 
 #include "game/stateless_systems/movement_path_system.h"
 #include "game/inferred_caches/tree_of_npo_cache.hpp"
 
+/*
+	Flat spatial hash of the tips of all flocking fish, built once per step.
+	Entries are sorted by their bucket, so every fish reads its neighborhood
+	from a few contiguous spans instead of querying the tree of npo.
+
+	Fish see their neighbors as they were at the beginning of the step.
+	Within a bucket, the entries keep the order of for_each_having,
+	so the order in which neighbors are visited is deterministic.
+*/
+
+struct flocking_fish {
+	entity_id id;
+	entity_flavour_id flavour;
+	render_layer layer;
+
+	vec2 pos;
+	vec2 tip;
+	vec2 vel;
+	real32 last_speed = 0.f;
+
+	int cell_x = 0;
+	int cell_y = 0;
+};
+
+class flocking_fish_hash {
+	std::vector<flocking_fish> unsorted;
+	std::vector<flocking_fish> entries;
+	std::vector<unsigned> bucket_starts;
+
+	real32 cell_size = 1.f;
+	unsigned bucket_mask = 0;
+
+	int cell_of(const real32 coord) const {
+		return static_cast<int>(repro::floor(coord / cell_size));
+	}
+
+	unsigned bucket_of(const int cell_x, const int cell_y) const {
+		return ((static_cast<unsigned>(cell_x) * 73856093u) ^ (static_cast<unsigned>(cell_y) * 19349663u)) & bucket_mask;
+	}
+
+public:
+	void clear(const real32 new_cell_size) {
+		unsorted.clear();
+		cell_size = new_cell_size;
+	}
+
+	void add(flocking_fish fish) {
+		fish.cell_x = cell_of(fish.tip.x);
+		fish.cell_y = cell_of(fish.tip.y);
+
+		unsorted.emplace_back(fish);
+	}
+
+	void build() {
+		unsigned num_buckets = 1;
+
+		while (num_buckets < unsorted.size() * 2) {
+			num_buckets *= 2;
+		}
+
+		bucket_mask = num_buckets - 1;
+		bucket_starts.assign(num_buckets + 1, 0);
+
+		for (const auto& f : unsorted) {
+			++bucket_starts[bucket_of(f.cell_x, f.cell_y) + 1];
+		}
+
+		for (unsigned i = 0; i < num_buckets; ++i) {
+			bucket_starts[i + 1] += bucket_starts[i];
+		}
+
+		entries.resize(unsorted.size());
+
+		thread_local std::vector<unsigned> cursors;
+		cursors.assign(bucket_starts.begin(), bucket_starts.end() - 1);
+
+		for (const auto& f : unsorted) {
+			entries[cursors[bucket_of(f.cell_x, f.cell_y)]++] = f;
+		}
+	}
+
+	template <class F>
+	void for_each_within(const vec2 center, const real32 radius, F&& callback) const {
+		if (entries.empty()) {
+			return;
+		}
+
+		const auto first_x = cell_of(center.x - radius);
+		const auto first_y = cell_of(center.y - radius);
+		const auto last_x = cell_of(center.x + radius);
+		const auto last_y = cell_of(center.y + radius);
+
+		for (int y = first_y; y <= last_y; ++y) {
+			for (int x = first_x; x <= last_x; ++x) {
+				const auto bucket = bucket_of(x, y);
+
+				const auto* it = entries.data() + bucket_starts[bucket];
+				const auto* const last = entries.data() + bucket_starts[bucket + 1];
+
+				for (; it != last; ++it) {
+					if (it->cell_x != x || it->cell_y != y) {
+						/* Another cell that landed in the same bucket. */
+						continue;
+					}
+
+					const auto offset = it->tip - center;
+
+					if (std::abs(offset.x) <= radius && std::abs(offset.y) <= radius) {
+						callback(*it);
+					}
+				}
+			}
+		}
+	}
+};
+
 void movement_path_system::advance_paths(const logic_step step) const {
 	auto& cosm = step.get_cosmos();
 	const auto delta = step.get_delta();
@@ -26,6 +144,48 @@ void movement_path_system::advance_paths(const logic_step step) const {
 	static const auto fov_half_degrees = real32((360 - 90) / 2);
 	static const auto fov_half_degrees_cos = repro::cos(fov_half_degrees);
 
+	const real32 comfort_zone_radius = 50.f;
+	const real32 cohesion_zone_radius = 60.f;
+
+	/* Thread local since several cosmoi might be solved at once, e.g. by a multi-arena server. */
+	thread_local flocking_fish_hash fish_hash;
+	fish_hash.clear(comfort_zone_radius);
+
+	cosm.for_each_having<components::movement_path>(
+		[&](const auto subject) {
+			const auto& movement_path_def = subject.template get<invariants::movement_path>();
+
+			if (!movement_path_def.fish_movement.is_enabled) {
+				return;
+			}
+
+			const auto layer = subject.template get<invariants::render>().layer;
+
+			if (layer != render_layer::UPPER_FISH && layer != render_layer::BOTTOM_FISH) {
+				return;
+			}
+
+			if (const auto tip = subject.find_logical_tip()) {
+				const auto transform = subject.get_logic_transform();
+				const auto last_speed = subject.template get<components::movement_path>().last_speed;
+
+				flocking_fish fish;
+
+				fish.id = subject.get_id();
+				fish.flavour = subject.get_flavour_id();
+				fish.layer = layer;
+				fish.pos = transform.pos;
+				fish.tip = *tip;
+				fish.vel = transform.get_direction() * last_speed;
+				fish.last_speed = last_speed;
+
+				fish_hash.add(fish);
+			}
+		}
+	);
+
+	fish_hash.build();
+
 	cosm.for_each_having<components::movement_path>(
 		[&](const auto subject) {
 			const auto& movement_path_def = subject.template get<invariants::movement_path>();
@@ -73,39 +233,22 @@ void movement_path_system::advance_paths(const logic_step step) const {
 
 				const auto current_dir = transform.get_direction();
 
-				const real32 comfort_zone_radius = 50.f;
-				const real32 cohesion_zone_radius = 60.f;
+				const auto subject_id = entity_id(subject.get_id());
 
 				auto for_each_neighbor_within = [&](const auto radius, auto callback) {
-					auto& neighbors = thread_local_visible_entities();
-
-					neighbors.acquire_non_physical({
-						cosm,
-						camera_cone(camera_eye(tip_pos), vec2::square(radius * 2)),
-						visible_entities_query::accuracy_type::PROXIMATE,
-						render_layer_filter::whitelist(
-							render_layer::UPPER_FISH,
-							render_layer::BOTTOM_FISH
-						),
-						{ tree_of_npo_type::ORGANISMS }
-					});
-
-					neighbors.for_all(cosm, [&](const auto handle) {
-						handle.template dispatch_on_having_all<components::movement_path>([&](const auto typed_neighbor) {
-							if (typed_neighbor.get_id() == subject.get_id()) {
-								/* Don't measure against itself */
-								return;
-							}
+					fish_hash.for_each_within(tip_pos, radius, [&](const flocking_fish& neighbor) {
+						if (neighbor.id == subject_id) {
+							/* Don't measure against itself */
+							return;
+						}
 
-							const auto neighbor_tip = *typed_neighbor.find_logical_tip();
-							const auto offset_dir = (neighbor_tip - tip_pos).normalize();
+						const auto offset_dir = (neighbor.tip - tip_pos).normalize();
 
-							const auto facing = current_dir.dot(offset_dir);
+						const auto facing = current_dir.dot(offset_dir);
 
-							if (facing < fov_half_degrees_cos) {
-								callback(typed_neighbor);
-							}
-						});
+						if (facing < fov_half_degrees_cos) {
+							callback(neighbor);
+						}
 					});
 				};
 
@@ -139,38 +282,29 @@ void movement_path_system::advance_paths(const logic_step step) const {
 
 					const auto subject_layer = subject.template get<invariants::render>().layer;
 
-					for_each_neighbor_within(comfort_zone_radius, [&](const auto typed_neighbor) {
-						const auto neighbor_layer = typed_neighbor.template get<invariants::render>().layer;
+					const auto subject_flavour = entity_flavour_id(subject.get_flavour_id());
 
-						if (int(subject_layer) > int(neighbor_layer)) {
+					for_each_neighbor_within(comfort_zone_radius, [&](const flocking_fish& neighbor) {
+						if (int(subject_layer) > int(neighbor.layer)) {
 							/* Don't avoid smaller species. */
 							return;
 						}
 
-						const auto& neighbor_path_def = typed_neighbor.template get<invariants::movement_path>();
-						const auto& neighbor_path = typed_neighbor.template get<components::movement_path>();
-
-						if (neighbor_path_def.fish_movement.is_enabled) {
-							const auto neighbor_transform = typed_neighbor.get_logic_transform();
-							const auto neighbor_vel = neighbor_transform.get_direction() * neighbor_path.last_speed;
-							const auto neighbor_tip = *typed_neighbor.find_logical_tip();
-
-							const auto avoidance = augs::immediate_avoidance(
-								tip_pos,
-								vec2(velocity).set_length(movement_path.last_speed),
-								neighbor_tip,
-								neighbor_vel,
-								comfort_zone_radius,
-								max_avoidance_speed * neighbor_path.last_speed / max_speed
-							);
-
-							greatest_avoidance = std::max(avoidance, greatest_avoidance);
-
-							if (typed_neighbor.get_flavour_id() == subject.get_flavour_id()) {
-								average_pos += neighbor_transform.pos;
-								average_vel += neighbor_transform.get_direction() * neighbor_path.last_speed;
-								++counted_neighbors;
-							}
+						const auto avoidance = augs::immediate_avoidance(
+							tip_pos,
+							vec2(velocity).set_length(movement_path.last_speed),
+							neighbor.tip,
+							neighbor.vel,
+							comfort_zone_radius,
+							max_avoidance_speed * neighbor.last_speed / max_speed
+						);
+
+						greatest_avoidance = std::max(avoidance, greatest_avoidance);
+
+						if (neighbor.flavour == subject_flavour) {
+							average_pos += neighbor.pos;
+							average_vel += neighbor.vel;
+							++counted_neighbors;
 						}
 					});
 
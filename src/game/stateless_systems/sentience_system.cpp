@@ -145,10 +145,9 @@ void sentience_system::regenerate_values_and_advance_spell_logic(const logic_ste
 		return static_cast<unsigned>(1 / delta.in_milliseconds() * m.regeneration_interval_ms);
 	};
 
-	cosm.for_each_having<components::sentience>(
-		[&](const auto& subject) {
+	cosm.for_each_component<components::sentience>(
+		[&](const auto& subject, components::sentience& sentience) {
 			const auto& sentience_def = subject.template get<invariants::sentience>();
-			components::sentience& sentience = subject.template get<components::sentience>();
 
 			auto& health = sentience.get<health_meter_instance>();
 			auto& consciousness = sentience.get<consciousness_meter_instance>();
@@ -607,10 +606,8 @@ void sentience_system::rotate_towards_crosshairs_and_driven_vehicles(const logic
 
 	auto& cosm = step.get_cosmos();
 
-	cosm.for_each_having<components::sentience>(
-		[&](const auto& subject) {
-			auto& sentience = subject.template get<components::sentience>();
-
+	cosm.for_each_component<components::sentience>(
+		[&](const auto& subject, components::sentience& sentience) {
 			if (!sentience.is_conscious()) {
 				return;
 			}
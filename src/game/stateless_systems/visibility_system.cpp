@@ -8,6 +8,7 @@
 #include "augs/math/math.h"
 #include "augs/templates/container_templates.h"
 #include "augs/templates/algorithm_templates.h"
+#include "augs/templates/range_workers.h"
 #include "augs/misc/simple_pair.h"
 #include "game/detail/physics/physics_queries.h"
 #include "game/debug_drawing_settings.h"
@@ -238,7 +239,7 @@ void visibility_system::calc_visibility(
 
 	using ray_output = physics_raycast_output;
 
-	for (const auto& request : vis_requests) {
+	auto calc_visibility_of = [&](const messages::visibility_information_request& request) {
 		const auto ignored_entity = request.subject;
 		const auto transform = request.eye_transform;
 		const auto request_index = index_in(vis_requests, request);
@@ -249,7 +250,7 @@ void visibility_system::calc_visibility(
 		response.source_queried_rect = request.queried_rect;
 
 		if (request.queried_rect.x < 1.f || request.queried_rect.y < 1.f) {
-			continue;
+			return;
 		}
 
 		thread_local std::vector <target_vertex> all_vertices_transformed;
@@ -983,5 +984,28 @@ void visibility_system::calc_visibility(
 				}
 			}
 		}
+	};
+
+	const bool debug_lines_requested = 
+		DEBUG_DRAWING.draw_cast_rays
+		|| DEBUG_DRAWING.draw_discontinuities
+		|| DEBUG_DRAWING.draw_triangle_edges
+	;
+
+	/*
+		Each request is calculated independently and writes only to its own response,
+		so the results are identical regardless of how the requests are sharded.
+		Debug lines go to a single shared vector, though, so drawing them forces the serial path.
+	*/
+
+	if (num_additional_workers == 0 || vis_requests.size() < 2 || debug_lines_requested) {
+		for (const auto& request : vis_requests) {
+			calc_visibility_of(request);
+		}
+	}
+	else {
+		static augs::range_workers<decltype(calc_visibility_of)> workers = num_additional_workers;
+		workers.resize_workers(num_additional_workers);
+		workers.process(calc_visibility_of, vis_requests);
 	}
 }
\ No newline at end of file
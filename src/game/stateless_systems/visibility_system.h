@@ -25,7 +25,21 @@ class visibility_system {
 
 public:
 	lines_ref DEBUG_LINES_TARGET;
-	visibility_system(lines_ref ref) : DEBUG_LINES_TARGET(ref) {}
+
+	/* 
+		If nonzero, batches of requests are sharded across this many workers besides the calling thread.
+		Results are bit-identical to the serial path.
+	*/
+
+	std::size_t num_additional_workers = 0;
+
+	visibility_system(
+		lines_ref ref,
+		const std::size_t num_additional_workers = 0
+	) : 
+		DEBUG_LINES_TARGET(ref),
+		num_additional_workers(num_additional_workers)
+	{}
 
 	messages::visibility_information_response& calc_visibility(
 		const cosmos&,
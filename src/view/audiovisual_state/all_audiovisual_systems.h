@@ -9,6 +9,7 @@
 #include "view/audiovisual_state/systems/pure_color_highlight_system.h"
 #include "view/audiovisual_state/systems/exploding_ring_system.h"
 #include "view/audiovisual_state/systems/thunder_system.h"
+#include "view/audiovisual_state/systems/static_batch_system.h"
 
 namespace augs {
 	template <class...>
@@ -25,5 +26,6 @@ using all_audiovisual_systems = augs::storage_for_systems<
 	flying_number_indicator_system,
 	pure_color_highlight_system,
 	exploding_ring_system,
-	thunder_system
+	thunder_system,
+	static_batch_system
 >;
\ No newline at end of file
@@ -16,5 +16,7 @@ struct audiovisual_profiler : public augs::profiler_mixin<audiovisual_profiler>
 	augs::time_measurements post_cleanup;
 
 	augs::amount_measurements<std::size_t> num_particles = 1;
+	augs::amount_measurements<std::size_t> light_visibility_cache_hits = 1;
+	augs::amount_measurements<std::size_t> light_visibility_cache_misses = 1;
 	// END GEN INTROSPECTOR
 };
\ No newline at end of file
@@ -72,7 +72,8 @@ void audiovisual_state::advance(const audiovisual_advance_input input) {
 				cosm,
 				dt,
 				anims,
-				interp
+				interp,
+				input.particle_integration_threads
 			);
 
 			performance.num_particles.measure(particles.count_all_particles());
@@ -93,7 +94,17 @@ void audiovisual_state::advance(const audiovisual_advance_input input) {
 		}
 	}
 
-	get<light_system>().advance_attenuation_variations(rng, cosm, dt);
+	{
+		auto& lights = get<light_system>();
+
+		lights.advance_attenuation_variations(rng, cosm, dt);
+
+		/* Rendering happens on a const state, so these are from the previous frame. */
+		const auto& stats = lights.last_visibility_cache_stats;
+
+		performance.light_visibility_cache_hits.measure(stats.hits);
+		performance.light_visibility_cache_misses.measure(stats.misses);
+	}
 
 	{
 		auto scope = measure_scope(performance.wandering_pixels);
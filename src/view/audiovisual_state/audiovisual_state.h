@@ -51,6 +51,8 @@ struct audiovisual_advance_input {
 	const loaded_sounds_map& sounds;
 	const augs::audio_volume_settings& audio_volume;
 	const sound_system_settings& sound_settings;
+
+	const unsigned particle_integration_threads;
 };
 
 struct audiovisual_state {
@@ -95,9 +95,8 @@ void interpolation_system::integrate_interpolated_transforms(
 
 	const float slowdown_multipliers_decrease = seconds / fixed_delta_for_slowdowns.in_seconds();
 
-	cosm.for_each_having<components::interpolation>( 
-		[&](const auto e) {
-			const auto info = e.template get<components::interpolation>();
+	cosm.for_each_component<components::interpolation>( 
+		[&](const auto e, const components::interpolation& info) {
 			const auto def = e.template get<invariants::interpolation>();
 
 			auto& integrated = get_interpolated(e);
@@ -7,7 +7,11 @@
 #include "game/cosmos/cosmos.h"
 #include "game/cosmos/for_each_entity.h"
 
+#include "augs/templates/hash_templates.h"
+
 #include "game/enums/filters.h"
+#include "game/detail/physics/physics_queries.h"
+#include "game/inferred_caches/physics_world_cache.h"
 
 #include "game/components/light_component.h"
 #include "game/components/render_component.h"
@@ -33,6 +37,123 @@
 #define LINEAR_MULT 10000
 #define QUADRATIC_MULT 10000000
 
+/*
+	Fixtures are identified by their geometry, never by their addresses,
+	as a fixture recreated with a new shape usually lands in the very same block of the allocator.
+*/
+
+static std::size_t hash_fixture_geometry(const b2Fixture& f) {
+	const auto& filter = f.GetFilterData();
+
+	auto result = augs::hash_multiple(
+		get_body_entity_that_owns(f),
+		f.IsSensor(),
+		filter.categoryBits,
+		filter.maskBits,
+		filter.groupIndex
+	);
+
+	auto hash_vertices = [&result](const b2Vec2* const vertices, const int32 count) {
+		augs::hash_combine(result, count);
+
+		for (int32 i = 0; i < count; ++i) {
+			augs::hash_combine(result, vertices[i].x, vertices[i].y);
+		}
+	};
+
+	const auto shape = f.GetShape();
+
+	augs::hash_combine(result, shape->GetType(), shape->m_radius);
+
+	switch (shape->GetType()) {
+		case b2Shape::e_circle: {
+			const auto& circle = *static_cast<const b2CircleShape*>(shape);
+			augs::hash_combine(result, circle.m_p.x, circle.m_p.y);
+			break;
+		}
+
+		case b2Shape::e_edge: {
+			const auto& edge = *static_cast<const b2EdgeShape*>(shape);
+			augs::hash_combine(result, edge.m_vertex1.x, edge.m_vertex1.y, edge.m_vertex2.x, edge.m_vertex2.y);
+			break;
+		}
+
+		case b2Shape::e_polygon: {
+			const auto& polygon = *static_cast<const b2PolygonShape*>(shape);
+			hash_vertices(polygon.m_vertices, polygon.m_count);
+			break;
+		}
+
+		case b2Shape::e_chain: {
+			const auto& chain = *static_cast<const b2ChainShape*>(shape);
+			hash_vertices(chain.m_vertices, chain.m_count);
+			break;
+		}
+
+		default:
+			break;
+	}
+
+	return result;
+}
+
+/*
+	Summarizes every fixture that the visibility system would consider for this request.
+	The fixtures are combined regardless of the order in which the broadphase reports them.
+*/
+
+std::size_t light_system::hash_surroundings(
+	const cosmos& cosm,
+	const messages::visibility_information_request& request
+) {
+	const auto si = cosm.get_si();
+	const auto& physics = cosm.get_solvable_inferred().physics;
+
+	const vec2 eye_meters = si.get_meters(request.eye_transform.pos + request.offset);
+	const auto vision_meters = si.get_meters(request.queried_rect);
+
+	b2AABB aabb;
+	aabb.lowerBound = b2Vec2(eye_meters - vision_meters / 2);
+	aabb.upperBound = b2Vec2(eye_meters + vision_meters / 2);
+
+	std::size_t num_fixtures = 0;
+	std::size_t fixtures_hash = 0;
+
+	physics.for_each_in_aabb_meters(
+		aabb,
+		request.filter,
+		[&](const b2Fixture& f) {
+			const auto xf = f.GetBody()->GetTransform();
+
+			fixtures_hash += augs::hash_multiple(
+				hash_fixture_geometry(f),
+				xf.p.x,
+				xf.p.y,
+				xf.q.s,
+				xf.q.c
+			);
+
+			++num_fixtures;
+
+			return callback_result::CONTINUE;
+		}
+	);
+
+	return augs::hash_multiple(fixtures_hash, num_fixtures);
+}
+
+bool light_system::visibility_cache::is_valid_for(
+	const messages::visibility_information_request& request,
+	const std::size_t surroundings_hash
+) const {
+	return 
+		is_set
+		&& eye_transform == request.eye_transform
+		&& queried_rect == request.queried_rect
+		&& this->surroundings_hash == surroundings_hash
+	;
+}
+
 void light_system::reserve_caches_for_entities(const std::size_t n) {
 	per_entity_cache.reserve(n);
 }
@@ -159,6 +280,17 @@ void light_system::render_all_lights(const light_system_input in) const {
 		return c.get_visible_world_rect_aabb();
 	}();
 
+	/* Only the lights whose cached visibility has gone stale are recalculated. */
+
+	thread_local visibility_requests recalculated_requests;
+	thread_local std::vector<const light_system::cache*> recalculated_caches;
+
+	recalculated_requests.clear();
+	recalculated_caches.clear();
+
+	auto& stats = last_visibility_cache_stats;
+	stats = {};
+
 	{
 		auto scope = measure_scope(performance.light_visibility);
 
@@ -188,14 +320,53 @@ void light_system::render_all_lights(const light_system_input in) const {
 
 					request.subject = light_entity;
 
+					if (request.queried_rect.x >= 1.f && request.queried_rect.y >= 1.f) {
+						auto& cached = cache->visibility;
+						const auto surroundings_hash = hash_surroundings(cosm, request);
+
+						if (cached.is_valid_for(request, surroundings_hash)) {
+							++stats.hits;
+						}
+						else {
+							++stats.misses;
+
+							cached.is_set = false;
+							cached.eye_transform = request.eye_transform;
+							cached.queried_rect = request.queried_rect;
+							cached.surroundings_hash = surroundings_hash;
+
+							recalculated_requests.push_back(request);
+							recalculated_caches.push_back(cache);
+						}
+					}
+
 					requests.emplace_back(std::move(request));
 				}
 			}
 		);
 
-		visibility_system(DEBUG_FRAME_LINES).calc_visibility(cosm, requests, responses);
+		visibility_system(DEBUG_FRAME_LINES, in.visibility_threads).calc_visibility(cosm, recalculated_requests, responses);
+
+		for (std::size_t i = 0; i < recalculated_requests.size(); ++i) {
+			auto& cached = recalculated_caches[i]->visibility;
+
+			cached.response = responses[i];
+			cached.is_set = true;
+		}
 	}
 
+	static const auto no_visibility = messages::visibility_information_response();
+
+	auto get_visibility_of = [&](const messages::visibility_information_request& request) -> const messages::visibility_information_response& {
+		const auto& cached = per_entity_cache.at(request.subject).visibility;
+
+		if (cached.is_set && request.queried_rect == cached.queried_rect) {
+			return cached.response;
+		}
+
+		return no_visibility;
+	};
+
 	auto scope = measure_scope(performance.light_rendering);
 
 	renderer.set_additive_blending();
@@ -204,7 +375,7 @@ void light_system::render_all_lights(const light_system_input in) const {
 	std::size_t num_wall_lights = 0;
 
 	for (size_t i = 0; i < requests.size(); ++i) {
-		const auto& r = responses[i];
+		const auto& r = get_visibility_of(requests[i]);
 		const auto& light_entity = cosm[requests[i].subject];
 		const auto& light = light_entity.get<components::light>();
 		const auto world_light_pos = requests[i].eye_transform.pos;
@@ -429,4 +600,59 @@ void light_system::render_all_lights(const light_system_input in) const {
 	renderer.set_active_texture(2);
 	in.light_fbo.get_texture().bind();
 	renderer.set_active_texture(0);
-}
\ No newline at end of file
+}
+
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <Catch/single_include/catch2/catch.hpp>
+
+#include "augs/misc/lua/lua_utils.h"
+#include "game/cosmos/cosmic_functions.h"
+#include "game/modes/test_mode.h"
+#include "application/intercosm.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+
+TEST_CASE("LightSystem ResizedWallInvalidatesVisibility") {
+	auto lua = augs::create_lua_state();
+
+	/* Intercosm is too big for the stack. */
+	const auto scene = std::make_unique<intercosm>();
+	test_mode_ruleset ruleset;
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	auto& cosm = scene->world;
+
+	/* Far away from the rest of the scene. */
+	const auto wall_pos = vec2(100000.f, 100000.f);
+	const auto wall = create_test_scene_entity(cosm, test_plain_sprited_bodies::BRICK_WALL, wall_pos);
+
+	REQUIRE(wall.alive());
+
+	messages::visibility_information_request request;
+	request.eye_transform = transformr(wall_pos - vec2(300.f, 0.f), 0.f);
+	request.filter = predefined_queries::line_of_sight();
+	request.queried_rect = vec2(1000.f, 1000.f);
+	request.subject = wall.get_id();
+
+	auto calc_hash = [&]() {
+		return light_system::hash_surroundings(cosm, request);
+	};
+
+	light_system::visibility_cache cached;
+	cached.is_set = true;
+	cached.eye_transform = request.eye_transform;
+	cached.queried_rect = request.queried_rect;
+	cached.surroundings_hash = calc_hash();
+
+	REQUIRE(cached.is_valid_for(request, calc_hash()));
+
+	/* Recreating the very same fixtures must not invalidate anything. */
+	cosmic::reinfer_all_entities(cosm);
+	REQUIRE(cached.is_valid_for(request, calc_hash()));
+
+	/* The resized fixture is likely to be allocated where the old one was. */
+	wall.get<components::overridden_geo>().set(wall.get_logical_size() * 2);
+	REQUIRE(!cached.is_valid_for(request, calc_hash()));
+}
+#endif
@@ -10,6 +10,7 @@
 #include "view/audiovisual_state/systems/audiovisual_cache_common.h"
 
 #include "game/detail/visible_entities.h"
+#include "game/messages/visibility_information.h"
 
 class interpolation_system;
 class particles_simulation_system;
@@ -49,14 +50,44 @@ struct light_system_input {
 
 	const augs::atlas_entry cast_highlight_tex;
 	const draw_renderable_input& drawing_in;
+	const unsigned visibility_threads;
 };
 
 struct light_system {
+	/*
+		Visibility of a light from the last time it was calculated.
+
+		It stays valid as long as the light does not move
+		and no fixture within its reach moves, changes, appears or disappears.
+		The fixtures are summarized by a hash, so that validating is a single broadphase query instead of a raycast per vertex.
+	*/
+
+	struct visibility_cache {
+		bool is_set = false;
+
+		transformr eye_transform;
+		vec2 queried_rect;
+		std::size_t surroundings_hash = 0;
+
+		messages::visibility_information_response response;
+
+		bool is_valid_for(const messages::visibility_information_request&, std::size_t surroundings_hash) const;
+	};
+
 	struct cache {
 		std::array<float, 10> all_variation_values = {};
+		mutable visibility_cache visibility;
+	};
+
+	struct visibility_cache_stats {
+		std::size_t hits = 0;
+		std::size_t misses = 0;
 	};
 
 	audiovisual_cache_map<cache> per_entity_cache;
+	mutable visibility_cache_stats last_visibility_cache_stats;
+
+	static std::size_t hash_surroundings(const cosmos&, const messages::visibility_information_request&);
 
 	void reserve_caches_for_entities(const size_t);
 	void clear();
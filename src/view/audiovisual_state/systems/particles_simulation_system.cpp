@@ -1,4 +1,5 @@
 #include "augs/templates/container_templates.h"
+#include "augs/templates/range_workers.h"
 #include "game/detail/physics/physics_queries.h"
 
 #include "augs/misc/randomization.h"
@@ -150,7 +151,7 @@ void particles_simulation_system::clear() {
 void particles_simulation_system::add_particle(const particle_layer l, const general_particle& p) {
 	auto& v = general_particles[l];
 
-	if (container_full(v)) {
+	if (v.full()) {
 		return;
 	}
 
@@ -160,7 +161,7 @@ void particles_simulation_system::add_particle(const particle_layer l, const gen
 void particles_simulation_system::add_particle(const particle_layer l, const animated_particle& p) {
 	auto& v = animated_particles[l];
 
-	if (container_full(v)) {
+	if (v.full()) {
 		return;
 	}
 
@@ -240,29 +241,77 @@ void particles_simulation_system::update_effects_from_messages(
 	}
 }
 
+namespace {
+	/* Small enough to balance the work among the threads, big enough to amortize taking it. */
+	constexpr std::size_t particles_per_chunk = 1024;
+
+	struct particle_integration_chunk {
+		general_particle_columns* general = nullptr;
+		animated_particle_columns* animated = nullptr;
+
+		std::size_t first = 0;
+		std::size_t last = 0;
+	};
+
+	struct particle_integration_runner {
+		float dt = 0.f;
+		const plain_animations_pool* anims = nullptr;
+
+		void operator()(particle_integration_chunk& chunk) const {
+			if (chunk.general) {
+				chunk.general->integrate(chunk.first, chunk.last, dt);
+			}
+			else {
+				chunk.animated->integrate(chunk.first, chunk.last, dt, *anims);
+			}
+		}
+	};
+}
+
 void particles_simulation_system::integrate_all_particles(
 	const cosmos& cosm,
 	const augs::delta delta,
 	const plain_animations_pool& anims,
-	const interpolation_system& interp
+	const interpolation_system& interp,
+	const std::size_t num_additional_workers
 ) {
-	const auto dead_particles_remover = [](auto& container) {
-		erase_if(container, [](const auto& a) { return a.is_dead(); });
-	};
+	const auto dt = delta.in_seconds();
 
-	for (auto& particle_layer : general_particles) {
-		dead_particles_remover(particle_layer);
+	{
+		thread_local std::vector<particle_integration_chunk> chunks;
+		chunks.clear();
+
+		auto add_chunks = [&](auto& layer, auto member) {
+			layer.remove_dead();
 
-		for (auto& p : particle_layer) {
-			p.integrate(delta.in_seconds());
+			for (std::size_t first = 0; first < layer.size(); first += particles_per_chunk) {
+				auto& chunk = chunks.emplace_back();
+
+				chunk.*member = std::addressof(layer);
+				chunk.first = first;
+				chunk.last = std::min(layer.size(), first + particles_per_chunk);
+			}
+		};
+
+		for (auto& particle_layer : general_particles) {
+			add_chunks(particle_layer, &particle_integration_chunk::general);
 		}
-	}
 
-	for (auto& particle_layer : animated_particles) {
-		dead_particles_remover(particle_layer);
+		for (auto& particle_layer : animated_particles) {
+			add_chunks(particle_layer, &particle_integration_chunk::animated);
+		}
 
-		for (auto& p : particle_layer) {
-			p.integrate(delta.in_seconds(), anims);
+		const auto runner = particle_integration_runner { dt, std::addressof(anims) };
+
+		if (num_additional_workers == 0 || chunks.size() < 2) {
+			for (auto& chunk : chunks) {
+				runner(chunk);
+			}
+		}
+		else {
+			static augs::range_workers<particle_integration_runner> workers = num_additional_workers;
+			workers.resize_workers(num_additional_workers);
+			workers.process(runner, chunks);
 		}
 	}
 
@@ -270,19 +319,20 @@ void particles_simulation_system::integrate_all_particles(
 		erase_if(particle_layer, [&](auto& cluster) {
 			const auto homing_target = cosm[cluster.first];
 
-			if (homing_target.alive()) {
-				dead_particles_remover(cluster.second);
+			if (!homing_target.alive()) {
+				return true;
+			}
 
-				const auto homing_transform = cosm[cluster.first].get_viewing_transform(interp);
+			erase_if(cluster.second, [](const auto& p) { return p.is_dead(); });
 
-				for (auto& p : cluster.second) {
-					p.integrate(delta.in_seconds(), homing_transform.pos, anims);
-				}
+			/* Resolved once for the whole cluster. */
+			const auto homing_pos = homing_target.get_viewing_transform(interp).pos;
 
-				return cluster.second.empty();
+			for (auto& p : cluster.second) {
+				p.integrate(dt, homing_pos, anims);
 			}
 
-			return true;
+			return cluster.second.empty();
 		});
 	}
 }
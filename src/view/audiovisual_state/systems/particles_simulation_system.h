@@ -14,6 +14,7 @@
 #include "view/audiovisual_state/systems/audiovisual_cache_common.h"
 #include "view/viewables/all_viewables_declaration.h"
 #include "view/viewables/particle_effect.h"
+#include "view/viewables/particle_columns.h"
 
 class interpolation_system;
 struct randomization;
@@ -133,12 +134,9 @@ public:
 		{}
 	};
 
-	template <class T>
-	using make_particle_vector = augs::constant_size_vector<T, T::statically_allocate>;
-
-	/* Particle vectors */
-	per_particle_layer_t<make_particle_vector<general_particle>> general_particles;
-	per_particle_layer_t<make_particle_vector<animated_particle>> animated_particles;
+	/* Particle columns */
+	per_particle_layer_t<general_particle_columns> general_particles;
+	per_particle_layer_t<animated_particle_columns> animated_particles;
 
 	/* Here we must have a vector as we would be forced to allocate memory every time we begin an emission */
 	per_particle_layer_t<std::unordered_map<entity_id, std::vector<homing_animated_particle>>> homing_animated_particles;
@@ -231,7 +229,8 @@ public:
 		const cosmos&,
 		augs::delta dt,
 		const plain_animations_pool& anims,
-		const interpolation_system&
+		const interpolation_system&,
+		std::size_t num_additional_workers = 0
 	);
 
 	void advance_visible_streams(
@@ -258,13 +257,8 @@ public:
 		const draw_particles_input input,
 		const particle_layer layer
 	) const {
-		for (const auto& it : general_particles[layer]) {
-			it.draw_as_sprite(manager, input);
-		}
-
-		for (const auto& it : animated_particles[layer]) {
-			it.draw_as_sprite(manager, anims, input);
-		}
+		general_particles[layer].draw(manager, input);
+		animated_particles[layer].draw(manager, anims, input);
 
 		for (const auto& cluster : homing_animated_particles[layer]) {
 			for (const auto& it : cluster.second) {
@@ -0,0 +1,603 @@
+#include <cmath>
+
+#include "augs/templates/hash_templates.h"
+#include "augs/templates/container_templates.h"
+#include "augs/templates/algorithm_templates.h"
+
+#include "game/cosmos/entity_handle.h"
+#include "game/cosmos/cosmos.h"
+#include "game/cosmos/for_each_entity.h"
+#include "game/detail/calc_render_layer.h"
+
+#include "view/viewables/image_in_atlas.h"
+#include "view/viewables/images_in_atlas_map.h"
+#include "view/rendering_scripts/draw_entity.h"
+
+#include "view/audiovisual_state/systems/static_batch_system.h"
+#include "view/audiovisual_state/systems/interpolation_system.h"
+
+template <class E>
+using is_static_scenery = std::is_same<E, sprite_decoration>;
+
+using baked_handle = const_typed_entity_handle<sprite_decoration>;
+
+static auto as_baked_id(const entity_id id) {
+	return typed_entity_id<sprite_decoration>(id.raw);
+}
+
+static vec2i calc_cell_of(const baked_handle handle) {
+	const auto pos = handle.get_logic_transform().pos / static_batch_system::cell_size;
+
+	return {
+		static_cast<int>(std::floor(pos.x)),
+		static_cast<int>(std::floor(pos.y))
+	};
+}
+
+static auto calc_drawn_sprite(const baked_handle handle) {
+	auto result = handle.get<invariants::sprite>();
+	const auto& overridden = handle.get<components::overridden_geo>().get();
+
+	if (overridden.is_enabled) {
+		result.size = overridden.value;
+	}
+
+	return result;
+}
+
+static bool can_be_baked(const baked_handle handle, const images_in_atlas_map& manager) {
+	if (!static_batch_system::is_baked_layer(::calc_render_layer(handle))) {
+		return false;
+	}
+
+	const auto sprite = calc_drawn_sprite(handle);
+
+	if (sprite.effect != augs::sprite_special_effect::NONE) {
+		return false;
+	}
+
+	if (sprite.neon_intensity_vibration.is_enabled && sprite.vibrate_diffuse_as_well) {
+		return false;
+	}
+
+	if (sprite.tile_excess_size) {
+		/* Only the tiles in view are drawn. */
+		const auto original_size = vec2i(manager.at(sprite.image_id).get_original_size());
+
+		if (sprite.get_size() != original_size) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/* Covers everything that the baked triangles of a decoration depend on. */
+
+static std::size_t hash_baked_appearance(const baked_handle handle, const images_in_atlas_map& manager) {
+	const auto sprite = calc_drawn_sprite(handle);
+	const auto flip = handle.get<components::overridden_geo>().get_raw_component().flip;
+	const auto colorize = handle.get<components::sprite>().colorize;
+	const auto& entry = manager.at(sprite.image_id).diffuse;
+
+	return augs::hash_multiple(
+		handle.get_id(),
+		handle.get_logic_transform(),
+		sprite.image_id,
+		sprite.size,
+		sprite.color.r,
+		sprite.color.g,
+		sprite.color.b,
+		sprite.color.a,
+		colorize.r,
+		colorize.g,
+		colorize.b,
+		colorize.a,
+		flip.horizontally,
+		flip.vertically,
+		entry.atlas_space.x,
+		entry.atlas_space.y,
+		entry.atlas_space.w,
+		entry.atlas_space.h,
+		entry.was_flipped
+	);
+}
+
+bool static_batch_system::is_baked_layer(const render_layer layer) {
+	switch (layer) {
+		case render_layer::UNDER_GROUND:
+		case render_layer::GROUND:
+		case render_layer::FLOOR_AND_ROAD:
+		case render_layer::ON_FLOOR:
+		case render_layer::ON_ON_FLOOR:
+		case render_layer::AQUARIUM_FLOWERS:
+		case render_layer::AQUARIUM_DUNES:
+			return true;
+
+		default:
+			return false;
+	}
+}
+
+void static_batch_system::clear() {
+	for (auto& layer : cells) {
+		layer.clear();
+	}
+
+	for (auto& layer : visible_cells) {
+		layer.clear();
+	}
+
+	locations.clear();
+	baked_images.clear();
+
+	assigned_for = nullptr;
+	assigned_num_pool_changes = 0;
+	scenery_key = 0;
+	changed_in_place = false;
+}
+
+void static_batch_system::mark_changed_in_place() {
+	changed_in_place = true;
+}
+
+std::size_t static_batch_system::calc_scenery_key(const static_batch_update_input in) const {
+	const auto& cosm = in.cosm;
+	const auto& solvable = cosm.get_solvable();
+	const auto& manager = in.drawing_in.manager;
+
+	auto key = augs::hash_multiple(
+		std::addressof(cosm),
+		solvable.significant.assignment_detector.count,
+		solvable.get_num_destroyed_caches(),
+		solvable.get_num_pool_changes<sprite_decoration>()
+	);
+
+	/* The atlas might be regenerated while the cosmos stays the same. */
+
+	for (const auto image_id : baked_images) {
+		const auto& entry = manager.at(image_id).diffuse;
+
+		augs::hash_combine(
+			key,
+			entry.atlas_space.x,
+			entry.atlas_space.y,
+			entry.atlas_space.w,
+			entry.atlas_space.h,
+			entry.was_flipped
+		);
+	}
+
+	return key;
+}
+
+void static_batch_system::reassign_cells(const static_batch_update_input in) const {
+	const auto& cosm = in.cosm;
+	const auto& manager = in.drawing_in.manager;
+
+	per_render_layer_t<cells_map> reassigned;
+	locations.clear();
+	baked_images.clear();
+
+	cosm.for_each_entity<is_static_scenery>([&](const auto& typed_handle) {
+		const auto handle = cosm[typed_handle.get_id()];
+
+		if (!can_be_baked(handle, manager)) {
+			return;
+		}
+
+		const auto id = entity_id(handle.get_id());
+		const auto layer = ::calc_render_layer(handle);
+		const auto cell_id = calc_cell_of(handle);
+
+		auto& cell = reassigned[layer][cell_id];
+
+		cell.members.push_back(id);
+		cell.signature += hash_baked_appearance(handle, manager);
+		cell.validated_in_version = scenery_version;
+
+		baked_images.push_back(calc_drawn_sprite(handle).image_id);
+
+		if (const auto aabb = handle.find_aabb()) {
+			cell.bounds.contain(*aabb);
+		}
+
+		locations[unversioned_entity_id(id)] = { id, layer, cell_id };
+	});
+
+	/* The cells whose contents did not change keep their triangles. */
+
+	for (std::size_t l = 0; l < reassigned.size(); ++l) {
+		for (auto& it : reassigned[l]) {
+			auto& cell = it.second;
+
+			if (const auto previous = mapped_or_nullptr(cells[l], it.first)) {
+				if (previous->baked && previous->signature == cell.signature) {
+					cell.triangles = std::move(previous->triangles);
+					cell.baked = true;
+				}
+			}
+		}
+	}
+
+	cells = std::move(reassigned);
+
+	sort_range(baked_images, std::less<>());
+	remove_duplicates_from_sorted(baked_images);
+
+	assigned_for = std::addressof(cosm);
+	assigned_num_pool_changes = cosm.get_solvable().get_num_pool_changes<sprite_decoration>();
+}
+
+bool static_batch_system::validate_visible_cells(const static_batch_update_input in) const {
+	const auto& cosm = in.cosm;
+	const auto& manager = in.drawing_in.manager;
+	const auto camera_aabb = in.drawing_in.cone.get_visible_world_rect_aabb();
+
+	for (std::size_t l = 0; l < cells.size(); ++l) {
+		const auto layer = static_cast<render_layer>(l);
+
+		auto& visible_in_layer = visible_cells[l];
+		visible_in_layer.clear();
+
+		for (auto& it : cells[l]) {
+			auto& cell = it.second;
+
+			if (!camera_aabb.hover(cell.bounds)) {
+				continue;
+			}
+
+			visible_in_layer.push_back(std::addressof(cell));
+
+			if (cell.validated_in_version == scenery_version) {
+				continue;
+			}
+
+			std::size_t signature = 0;
+
+			for (const auto id : cell.members) {
+				const auto handle = cosm[as_baked_id(id)];
+
+				const bool still_here =
+					handle.alive()
+					&& can_be_baked(handle, manager)
+					&& ::calc_render_layer(handle) == layer
+					&& calc_cell_of(handle) == it.first
+				;
+
+				if (!still_here) {
+					return false;
+				}
+
+				signature += hash_baked_appearance(handle, manager);
+			}
+
+			if (signature != cell.signature) {
+				cell.signature = signature;
+				cell.baked = false;
+			}
+
+			cell.validated_in_frame = current_frame;
+			cell.validated_in_version = scenery_version;
+		}
+	}
+
+	return true;
+}
+
+bool static_batch_system::are_visible_decorations_assigned(const static_batch_update_input in) const {
+	const auto& cosm = in.cosm;
+	const auto& manager = in.drawing_in.manager;
+
+	bool all_assigned = true;
+
+	in.visible.for_all_ids([&](const entity_id id) {
+		if (!all_assigned || !id.type_id.is<sprite_decoration>()) {
+			return;
+		}
+
+		const auto handle = cosm[as_baked_id(id)];
+
+		if (handle.dead()) {
+			return;
+		}
+
+		const auto assigned = mapped_or_nullptr(locations, unversioned_entity_id(id));
+
+		if (assigned == nullptr || assigned->id != id) {
+			/* Only a decoration that could be baked, but was not, is a sign of a change. */
+			all_assigned = !can_be_baked(handle, manager);
+			return;
+		}
+
+		const auto cell = mapped_or_nullptr(cells[assigned->layer], assigned->cell);
+
+		if (cell == nullptr) {
+			all_assigned = false;
+			return;
+		}
+
+		if (cell->validated_in_frame == current_frame) {
+			/* Already checked together with the whole cell. */
+			return;
+		}
+
+		all_assigned =
+			::calc_render_layer(handle) == assigned->layer
+			&& calc_cell_of(handle) == assigned->cell
+		;
+	});
+
+	return all_assigned;
+}
+
+void static_batch_system::bake(baked_cell& cell, const static_batch_update_input in) const {
+	const auto& d = in.drawing_in;
+
+	cell.triangles.clear();
+	cell.bounds = ltrb();
+
+	const auto baking_in = draw_renderable_input {
+		{ augs::drawer { cell.triangles }, d.manager, d.global_time_seconds, d.flip, d.randomizing, d.cone },
+		d.interp
+	};
+
+	for (const auto id : cell.members) {
+		const auto handle = in.cosm[id];
+
+		::draw_entity(handle, baking_in);
+
+		if (const auto aabb = handle.find_aabb()) {
+			cell.bounds.contain(*aabb);
+		}
+	}
+
+	cell.baked = true;
+}
+
+void static_batch_system::update(const static_batch_update_input in) const {
+	const auto& cosm = in.cosm;
+
+	++current_frame;
+	last_update_stats = {};
+
+	const auto new_scenery_key = calc_scenery_key(in);
+	const bool scenery_changed = changed_in_place || new_scenery_key != scenery_key;
+
+	if (scenery_changed) {
+		scenery_key = new_scenery_key;
+		changed_in_place = false;
+		++scenery_version;
+	}
+
+	const bool decorations_changed =
+		assigned_for != std::addressof(cosm)
+		|| assigned_num_pool_changes != cosm.get_solvable().get_num_pool_changes<sprite_decoration>()
+	;
+
+	if (decorations_changed) {
+		reassign_cells(in);
+	}
+
+	/*
+		Until the scenery changes, the assignment of the decorations that come into view
+		could not have changed either, so only the newly visible cells need validation.
+	*/
+
+	const bool needs_reassignment =
+		!validate_visible_cells(in)
+		|| (scenery_changed && !are_visible_decorations_assigned(in))
+	;
+
+	if (needs_reassignment) {
+		reassign_cells(in);
+		validate_visible_cells(in);
+	}
+
+	for (const auto& layer : visible_cells) {
+		for (auto* const cell : layer) {
+			if (!cell->baked) {
+				bake(*cell, in);
+				++last_update_stats.rebaked_cells;
+			}
+
+			last_update_stats.drawn_triangles += cell->triangles.size();
+		}
+	}
+}
+
+void static_batch_system::draw(const render_layer layer, const augs::drawer& output) const {
+	for (const auto* const cell : visible_cells[layer]) {
+		concatenate(output.output_buffer, cell->triangles);
+	}
+}
+
+bool static_batch_system::is_baked(const entity_id id) const {
+	if (!id.type_id.is<sprite_decoration>()) {
+		return false;
+	}
+
+	if (const auto assigned = mapped_or_nullptr(locations, unversioned_entity_id(id))) {
+		return assigned->id == id;
+	}
+
+	return false;
+}
+
+#if BUILD_UNIT_TESTS && BUILD_TEST_SCENES
+#include <cstring>
+#include <Catch/single_include/catch2/catch.hpp>
+
+#include "augs/misc/lua/lua_utils.h"
+#include "game/cosmos/cosmic_functions.h"
+#include "game/modes/test_mode.h"
+#include "application/intercosm.h"
+#include "test_scenes/test_scene_settings.h"
+#include "test_scenes/create_test_scene_entity.h"
+#include "view/audiovisual_state/systems/randomizing_system.h"
+
+namespace {
+	using triangle_bytes = std::array<std::byte, sizeof(augs::vertex_triangle)>;
+
+	/* The batches draw the decorations cell by cell, so only the set of the triangles is compared. */
+
+	auto sorted_triangles(const augs::vertex_triangle_buffer& triangles) {
+		std::vector<triangle_bytes> result(triangles.size());
+
+		for (std::size_t i = 0; i < triangles.size(); ++i) {
+			std::memcpy(result[i].data(), std::addressof(triangles[i]), sizeof(augs::vertex_triangle));
+		}
+
+		sort_range(result);
+		return result;
+	}
+}
+
+TEST_CASE("StaticBatchSystem Invalidation") {
+	auto lua = augs::create_lua_state();
+
+	/* Intercosm is too big for the stack. */
+	const auto scene = std::make_unique<intercosm>();
+	test_mode_ruleset ruleset;
+
+	scene->make_test_scene(lua, { false, 60 }, ruleset);
+
+	auto& cosm = scene->world;
+
+	/* Far away from the rest of the test scene, so that only the decorations of this test are in view. */
+	const auto origin = vec2(100000.f, 100000.f);
+	const auto spacing = 100.f;
+
+	std::vector<typed_entity_id<sprite_decoration>> decorations;
+
+	for (int y = -1; y <= 1; ++y) {
+		for (int x = -1; x <= 1; ++x) {
+			const auto pos = origin + vec2(static_cast<float>(x), static_cast<float>(y)) * spacing;
+			decorations.push_back(create_test_scene_entity(cosm, test_sprite_decorations::AQUARIUM_SAND_1, pos).get_id());
+		}
+	}
+
+	const auto image_id = cosm[decorations[0]].get<invariants::sprite>().image_id;
+
+	/* All of these are too big for the stack. */
+	const auto manager = std::make_unique<images_in_atlas_map>();
+	const auto interp = std::make_unique<interpolation_system>();
+	const auto randomizing = std::make_unique<randomizing_system>();
+	const auto batches = std::make_unique<static_batch_system>();
+
+	(*manager)[image_id].diffuse.atlas_space = xywh(0.25f, 0.25f, 0.125f, 0.125f);
+
+	const auto cone = camera_cone(camera_eye(origin, 1.f), vec2i(1920, 1080));
+
+	visible_entities visible;
+	augs::vertex_triangle_buffer triangles;
+
+	const auto in = draw_renderable_input {
+		{ augs::drawer { triangles }, *manager, 0.0, flip_flags(), *randomizing, cone },
+		*interp
+	};
+
+	/*
+		Draws a frame through the batches and requires the very triangles
+		that drawing each decoration directly would produce.
+	*/
+
+	auto draw_frame = [&]() {
+		visible.reacquire_all_and_sort({
+			cosm,
+			cone,
+			visible_entities_query::accuracy_type::PROXIMATE,
+			visible_entities_query::dont_filter(),
+			tree_of_npo_filter::all_drawables()
+		});
+
+		triangles.clear();
+
+		batches->update({ cosm, visible, in });
+		batches->draw(render_layer::ON_FLOOR, in.drawer);
+
+		visible.for_each<render_layer::ON_FLOOR>(cosm, [&](const auto handle) {
+			if (!batches->is_baked(handle.get_id())) {
+				::draw_entity(handle, in);
+			}
+		});
+
+		const auto batched = sorted_triangles(triangles);
+
+		triangles.clear();
+
+		visible.for_each<render_layer::ON_FLOOR>(cosm, [&](const auto handle) {
+			::draw_entity(handle, in);
+		});
+
+		const auto expected = sorted_triangles(triangles);
+
+		REQUIRE(expected.size() > 0);
+		REQUIRE(batched == expected);
+
+		return expected;
+	};
+
+	const auto initial = draw_frame();
+
+	REQUIRE(batches->last_update_stats.rebaked_cells > 0);
+
+	for (const auto id : decorations) {
+		REQUIRE(batches->is_baked(id));
+	}
+
+	/* Nothing changed, so nothing is rebaked. */
+	REQUIRE(draw_frame() == initial);
+	REQUIRE(batches->last_update_stats.rebaked_cells == 0);
+
+	SECTION("Moving a decoration") {
+		/* Within its cell and into the neighboring one, which begins at x = 100352. */
+		cosm[decorations[0]].set_logic_transform(transformr(origin + vec2(10.f, 20.f), 0.f));
+		cosm[decorations[1]].set_logic_transform(transformr(origin + vec2(500.f, 0.f), 0.f));
+
+		/* Just like the editor after its commands. */
+		batches->mark_changed_in_place();
+
+		REQUIRE(draw_frame() != initial);
+		REQUIRE(batches->last_update_stats.rebaked_cells >= 2);
+		REQUIRE(batches->is_baked(decorations[0]));
+		REQUIRE(batches->is_baked(decorations[1]));
+	}
+
+	SECTION("Recoloring a decoration") {
+		cosm[decorations[4]].get<components::sprite>().colorize = rgba(255, 0, 0, 255);
+
+		batches->mark_changed_in_place();
+
+		REQUIRE(draw_frame() != initial);
+		REQUIRE(batches->last_update_stats.rebaked_cells == 1);
+	}
+
+	SECTION("Deleting a decoration and creating another in its place") {
+		const auto deleted = decorations[4];
+		const auto where = cosm[deleted].get_logic_transform();
+
+		cosmic::delete_entity(cosm[deleted]);
+
+		const auto created = create_test_scene_entity(cosm, test_sprite_decorations::AQUARIUM_SAND_1, where).get_id();
+
+		/* No mark_changed_in_place here - the count of decorations stays the same, but the batches must notice anyway. */
+
+		REQUIRE(created != deleted);
+		REQUIRE(cosm[deleted].dead());
+
+		draw_frame();
+
+		REQUIRE(batches->last_update_stats.rebaked_cells == 1);
+		REQUIRE(!batches->is_baked(deleted));
+		REQUIRE(batches->is_baked(created));
+	}
+
+	SECTION("Reloading the atlas") {
+		(*manager)[image_id].diffuse.atlas_space = xywh(0.5f, 0.25f, 0.25f, 0.125f);
+
+		REQUIRE(draw_frame() != initial);
+		REQUIRE(batches->last_update_stats.rebaked_cells > 0);
+	}
+}
+#endif
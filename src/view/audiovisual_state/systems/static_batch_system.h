@@ -0,0 +1,114 @@
+#pragma once
+#include <vector>
+#include <unordered_map>
+
+#include "augs/math/vec2.h"
+#include "augs/math/rects.h"
+#include "augs/graphics/vertex.h"
+
+#include "view/audiovisual_state/systems/audiovisual_cache_common.h"
+
+#include "game/assets/ids/asset_ids.h"
+#include "game/detail/visible_entities.h"
+
+class cosmos;
+class images_in_atlas_map;
+struct draw_renderable_input;
+
+namespace augs {
+	struct drawer;
+}
+
+struct static_batch_update_input {
+	const cosmos& cosm;
+	const visible_entities& visible;
+	const draw_renderable_input& drawing_in;
+};
+
+/*
+	Triangles of the scenery that practically never changes once the arena is loaded.
+
+	Sprite decorations in the floor layers are grouped by their render layer
+	and by the cell of a coarse grid that contains their center.
+	Each cell keeps the triangles of all its decorations,
+	so drawing a cell in view is a single copy into the triangle buffer.
+
+	Decorations whose triangles depend on time (special effects, vibrating neons)
+	or on the camera (tiled sprites) are never baked and are drawn as usual.
+
+	Nothing notifies this cache about changes, as the rendering only sees a const cosmos.
+	Instead, each frame calculates a cheap key of the scenery as a whole:
+	the cosmos, how many times it was assigned or reinferred, how many decorations were created or deleted
+	and the atlas entries of the baked images.
+	Whenever the key changes, or the editor reports that it modified the scenery in place,
+	the scenery version is incremented.
+
+	A cell in view is validated against a hash of whatever the triangles of its decorations depend on
+	only once per scenery version, so a camera over unchanged scenery does no per-decoration work at all.
+	A cell whose hash changes is rebaked alone.
+
+	Created, destroyed or moved decorations cause all decorations to be reassigned to cells,
+	but even then, only the cells whose contents have changed are rebaked.
+*/
+
+class static_batch_system {
+	struct baked_cell {
+		std::vector<entity_id> members;
+		std::size_t signature = 0;
+		ltrb bounds;
+		augs::vertex_triangle_buffer triangles;
+		bool baked = false;
+		unsigned validated_in_frame = 0;
+		unsigned validated_in_version = 0;
+	};
+
+	struct location {
+		entity_id id;
+		render_layer layer = render_layer::INVALID;
+		vec2i cell;
+	};
+
+	using cells_map = std::unordered_map<vec2i, baked_cell>;
+
+	mutable per_render_layer_t<cells_map> cells;
+	mutable per_render_layer_t<std::vector<baked_cell*>> visible_cells;
+	mutable audiovisual_cache_map<location> locations;
+
+	mutable const cosmos* assigned_for = nullptr;
+	mutable unsigned assigned_num_pool_changes = 0;
+	mutable unsigned current_frame = 0;
+
+	mutable std::vector<assets::image_id> baked_images;
+	mutable std::size_t scenery_key = 0;
+	mutable unsigned scenery_version = 0;
+	mutable bool changed_in_place = false;
+
+	std::size_t calc_scenery_key(const static_batch_update_input) const;
+	void reassign_cells(const static_batch_update_input) const;
+	bool validate_visible_cells(const static_batch_update_input) const;
+	bool are_visible_decorations_assigned(const static_batch_update_input) const;
+	void bake(baked_cell&, const static_batch_update_input) const;
+
+public:
+	static constexpr float cell_size = 1024.f;
+
+	struct update_stats {
+		std::size_t drawn_triangles = 0;
+		std::size_t rebaked_cells = 0;
+	};
+
+	mutable update_stats last_update_stats;
+
+	static bool is_baked_layer(render_layer);
+
+	void clear();
+
+	/* Called by the editor, whose commands modify the scenery in place. */
+	void mark_changed_in_place();
+
+	/* Must be called once per frame, before any of the layers are drawn. */
+	void update(const static_batch_update_input) const;
+
+	void draw(render_layer, const augs::drawer&) const;
+	bool is_baked(entity_id) const;
+};
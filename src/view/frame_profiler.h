@@ -12,6 +12,7 @@ struct frame_profiler : public augs::profiler_mixin<frame_profiler> {
 
 	augs::time_measurements rendering_script;
 	augs::time_measurements drawing_layers;
+	augs::time_measurements static_batches;
 	augs::time_measurements imgui;
 	augs::time_measurements menu_gui;
 	augs::time_measurements game_gui;
@@ -26,6 +27,8 @@ struct frame_profiler : public augs::profiler_mixin<frame_profiler> {
 	augs::amount_measurements<std::size_t> num_drawn_lights = 1;
 	augs::amount_measurements<std::size_t> num_drawn_wall_lights = 1;
 	augs::amount_measurements<std::size_t> num_visible_entities = 1;
+	augs::amount_measurements<std::size_t> num_static_batch_triangles = 1;
+	augs::amount_measurements<std::size_t> num_rebaked_static_cells = 1;
 	// END GEN INTROSPECTOR
 };
 
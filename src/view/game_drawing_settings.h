@@ -21,6 +21,9 @@ struct game_drawing_settings {
 	bool draw_cp_bar = true;
 	bool draw_pe_bar = false;
 
+	unsigned light_visibility_threads = 2;
+	unsigned particle_integration_threads = 2;
+
 	fog_of_war_settings fog_of_war;
 	fog_of_war_appearance_settings fog_of_war_appearance;
 	// END GEN INTROSPECTOR
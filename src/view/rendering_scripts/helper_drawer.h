@@ -2,6 +2,7 @@
 #include "view/rendering_scripts/draw_entity.h"
 #include "game/cosmos/cosmos.h"
 #include "game/detail/visible_entities.h"
+#include "view/audiovisual_state/systems/static_batch_system.h"
 
 struct helper_drawer {
 	const visible_entities& visible;
@@ -18,6 +19,35 @@ struct helper_drawer {
 		});
 	}
 
+	/*
+		Per layer, the baked cells in view go first,
+		then whatever visible entities were not baked into them.
+
+		A layer without any visible entities is skipped whole,
+		so that the layers hidden by a filter stay hidden.
+	*/
+
+	template <render_layer... r>
+	void draw_with_static_batches(const static_batch_system& batches) const {
+		auto scope = measure_scope(total_layer_scope);
+
+		auto draw_layer = [&](const auto layer) {
+			if (visible.empty(layer.value)) {
+				return;
+			}
+
+			batches.draw(layer.value, in.drawer);
+
+			visible.for_each<decltype(layer)::value>(cosm, [&](const auto handle) {
+				if (!batches.is_baked(handle.get_id())) {
+					::draw_entity(handle, in);
+				}
+			});
+		};
+
+		(draw_layer(std::integral_constant<render_layer, r>()), ...);
+	}
+
 	template <render_layer... r>
 	void draw_neons() const {
 		auto scope = measure_scope(total_layer_scope);
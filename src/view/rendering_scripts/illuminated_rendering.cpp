@@ -180,6 +180,19 @@ void illuminated_rendering(
 		interp
 	};
 
+	const auto& static_batches = av.get<static_batch_system>();
+
+	{
+		auto scope = measure_scope(profiler.static_batches);
+
+		static_batches.update({ cosm, visible, drawing_input });
+
+		const auto& stats = static_batches.last_update_stats;
+
+		profiler.num_static_batch_triangles.measure(stats.drawn_triangles);
+		profiler.num_rebaked_static_cells.measure(stats.rebaked_cells);
+	}
+
 	const bool fog_of_war_effective = 
 		viewed_character_transform != std::nullopt 
 		&& settings.fog_of_war.is_enabled()
@@ -354,7 +367,8 @@ void illuminated_rendering(
 		anims,
 		visible,
 		cast_highlight,
-		drawing_input
+		drawing_input,
+		settings.light_visibility_threads
 	});
 
 	set_shader_with_matrix(shaders.illuminated);
@@ -366,7 +380,7 @@ void illuminated_rendering(
 		total_layer_scope
 	};
 
-	helper.draw<
+	helper.draw_with_static_batches<
 		render_layer::UNDER_GROUND,
 		render_layer::GROUND,
 		render_layer::FLOOR_AND_ROAD,
@@ -380,7 +394,7 @@ void illuminated_rendering(
 		render_layer::BOTTOM_FISH,
 		render_layer::UPPER_FISH,
 		render_layer::AQUARIUM_BUBBLES
-	>();
+	>(static_batches);
 
 	visible.for_each<render_layer::DIM_WANDERING_PIXELS>(cosm, [&](const auto e) {
 		draw_wandering_pixels_as_sprites(wandering_pixels, e, game_images, drawing_input.make_input_for<invariants::sprite>());
@@ -0,0 +1,160 @@
+#include <vector>
+
+#include "augs/ensure.h"
+#include "view/viewables/particle_columns.h"
+
+namespace {
+	/* Shared by all columns of a layer so that they stay aligned. */
+	thread_local std::vector<std::size_t> survivors;
+
+	template <class F>
+	bool find_survivors(const std::size_t n, F is_dead) {
+		survivors.clear();
+
+		for (std::size_t i = 0; i < n; ++i) {
+			if (!is_dead(i)) {
+				survivors.push_back(i);
+			}
+		}
+
+		return survivors.size() != n;
+	}
+
+	template <class C>
+	void compact(C& column) {
+		const auto num_survivors = survivors.size();
+
+		for (std::size_t i = 0; i < num_survivors; ++i) {
+			if (survivors[i] != i) {
+				column[i] = std::move(column[survivors[i]]);
+			}
+		}
+	}
+
+	/* Same as augs::shrink, but without branches. */
+	float shrunk(const float val, const float amount) {
+		return std::copysign(std::max(0.f, std::abs(val) - amount), val);
+	}
+}
+
+void general_particle_columns::push_back(const general_particle& p) {
+	ensure_less(count, N);
+
+	const auto i = count++;
+
+	kinematics.write(i, p);
+
+	rotation[i] = p.rotation;
+	rotation_speed[i] = p.rotation_speed;
+	angular_damping[i] = p.angular_damping;
+	current_lifetime_ms[i] = p.current_lifetime_ms;
+	max_lifetime_ms[i] = p.max_lifetime_ms;
+
+	appearance[i] = {
+		p.image_id,
+		p.color,
+		p.size,
+		p.shrink_when_ms_remaining,
+		p.unshrinking_time_ms,
+		p.alpha_levels
+	};
+}
+
+general_particle general_particle_columns::get(const std::size_t i) const {
+	general_particle p;
+
+	kinematics.read_into(p, i);
+
+	p.rotation = rotation[i];
+	p.rotation_speed = rotation_speed[i];
+	p.angular_damping = angular_damping[i];
+	p.current_lifetime_ms = current_lifetime_ms[i];
+	p.max_lifetime_ms = max_lifetime_ms[i];
+
+	const auto& a = appearance[i];
+
+	p.image_id = a.image_id;
+	p.color = a.color;
+	p.size = a.size;
+	p.shrink_when_ms_remaining = a.shrink_when_ms_remaining;
+	p.unshrinking_time_ms = a.unshrinking_time_ms;
+	p.alpha_levels = a.alpha_levels;
+
+	return p;
+}
+
+void general_particle_columns::integrate(const std::size_t first, const std::size_t last, const float dt) {
+	kinematics.integrate(first, last, dt);
+
+	const auto lifetime_step = dt * 1000;
+
+	for (std::size_t i = first; i < last; ++i) {
+		current_lifetime_ms[i] += lifetime_step;
+
+		rotation[i] += rotation_speed[i] * dt;
+		rotation_speed[i] = shrunk(rotation_speed[i], angular_damping[i] * dt);
+	}
+}
+
+void general_particle_columns::remove_dead() {
+	const auto is_dead = [this](const std::size_t i) {
+		return current_lifetime_ms[i] >= max_lifetime_ms[i];
+	};
+
+	if (find_survivors(count, is_dead)) {
+		for_each_column([](auto& column) { compact(column); });
+		count = survivors.size();
+	}
+}
+
+void animated_particle_columns::push_back(const animated_particle& p) {
+	ensure_less(count, N);
+
+	const auto i = count++;
+
+	kinematics.write(i, p);
+
+	animation[i] = p.animation;
+	color[i] = p.color;
+}
+
+animated_particle animated_particle_columns::get(const std::size_t i) const {
+	animated_particle p;
+
+	kinematics.read_into(p, i);
+
+	p.animation = animation[i];
+	p.color = color[i];
+
+	return p;
+}
+
+void animated_particle_columns::integrate(
+	const std::size_t first,
+	const std::size_t last,
+	const float dt,
+	const plain_animations_pool& anims
+) {
+	for (std::size_t i = first; i < last; ++i) {
+		steps[i] = animation[i].should_integrate(anims) ? dt : 0.f;
+	}
+
+	kinematics.integrate(first, last, steps);
+
+	const auto animation_step = dt * 1000;
+
+	for (std::size_t i = first; i < last; ++i) {
+		animation[i].advance(animation_step, anims);
+	}
+}
+
+void animated_particle_columns::remove_dead() {
+	const auto is_dead = [this](const std::size_t i) {
+		return animation[i].is_dead();
+	};
+
+	if (find_survivors(count, is_dead)) {
+		for_each_column([](auto& column) { compact(column); });
+		count = survivors.size();
+	}
+}
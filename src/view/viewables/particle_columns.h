@@ -0,0 +1,228 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <limits>
+#include <cstddef>
+#include <algorithm>
+
+#include "view/viewables/particle_types.h"
+
+/*
+	Particles of a single layer stored as a structure of arrays.
+
+	Every quantity that changes during integration lives in its own float column,
+	so the integration loops stream through contiguous memory and can be vectorized by the compiler.
+	Whatever is only read when drawing is kept together in a separate column.
+
+	The columns are fixed-size arrays rather than vectors,
+	so that the compiler can tell they never overlap without checking it at runtime.
+
+	Integration is done on index ranges, so that disjoint chunks of a layer can be integrated by different threads.
+	Dead particles are removed in a single compacting pass that preserves the order of the living ones.
+*/
+
+template <std::size_t N>
+struct particle_kinematics_columns {
+	template <class T = float>
+	using column = std::array<T, N>;
+
+	column<> pos_x;
+	column<> pos_y;
+	column<> vel_x;
+	column<> vel_y;
+	column<> acc_x;
+	column<> acc_y;
+	column<> linear_damping;
+
+	template <class F>
+	void for_each_column(F&& callback) {
+		callback(pos_x);
+		callback(pos_y);
+		callback(vel_x);
+		callback(vel_y);
+		callback(acc_x);
+		callback(acc_y);
+		callback(linear_damping);
+	}
+
+	template <class T>
+	void write(const std::size_t i, const T& p) {
+		pos_x[i] = p.pos.x;
+		pos_y[i] = p.pos.y;
+		vel_x[i] = p.vel.x;
+		vel_y[i] = p.vel.y;
+		acc_x[i] = p.acc.x;
+		acc_y[i] = p.acc.y;
+		linear_damping[i] = p.linear_damping;
+	}
+
+	template <class T>
+	void read_into(T& p, const std::size_t i) const {
+		p.pos.set(pos_x[i], pos_y[i]);
+		p.vel.set(vel_x[i], vel_y[i]);
+		p.acc.set(acc_x[i], acc_y[i]);
+		p.linear_damping = linear_damping[i];
+	}
+
+	/*
+		Same as generic_integrate_particle, but for a range of particles.
+		Steps are either a single float or a column of them, one per particle.
+	*/
+
+	template <class S>
+	void integrate(const std::size_t first, const std::size_t last, const S& steps) {
+		for (std::size_t i = first; i < last; ++i) {
+			const auto dt = [&]() {
+				if constexpr(std::is_same_v<S, float>) {
+					return steps;
+				}
+				else {
+					return steps[i];
+				}
+			}();
+
+			vel_x[i] += acc_x[i] * dt;
+			vel_y[i] += acc_y[i] * dt;
+
+			pos_x[i] += vel_x[i] * dt;
+			pos_y[i] += vel_y[i] * dt;
+
+			/* Same as vec2::shrink, but without branches. */
+
+			const auto speed = std::sqrt(vel_x[i] * vel_x[i] + vel_y[i] * vel_y[i]);
+			const auto mult = std::max(0.f, speed - linear_damping[i] * dt) / std::max(speed, std::numeric_limits<float>::min());
+
+			vel_x[i] *= mult;
+			vel_y[i] *= mult;
+		}
+	}
+};
+
+struct general_particle_appearance {
+	assets::image_id image_id;
+	rgba color = white;
+	vec2i size;
+	float shrink_when_ms_remaining = 0.f;
+	float unshrinking_time_ms = 0.f;
+	int alpha_levels = -1;
+};
+
+class general_particle_columns {
+	static constexpr auto N = general_particle::statically_allocate;
+
+	template <class T = float>
+	using column = std::array<T, N>;
+
+	std::size_t count = 0;
+
+	particle_kinematics_columns<N> kinematics;
+
+	column<> rotation;
+	column<> rotation_speed;
+	column<> angular_damping;
+	column<> current_lifetime_ms;
+	column<> max_lifetime_ms;
+
+	column<general_particle_appearance> appearance;
+
+	template <class F>
+	void for_each_column(F&& callback) {
+		kinematics.for_each_column(callback);
+
+		callback(rotation);
+		callback(rotation_speed);
+		callback(angular_damping);
+		callback(current_lifetime_ms);
+		callback(max_lifetime_ms);
+		callback(appearance);
+	}
+
+public:
+	std::size_t size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	bool full() const {
+		return count == N;
+	}
+
+	void clear() {
+		count = 0;
+	}
+
+	void push_back(const general_particle&);
+	general_particle get(std::size_t i) const;
+
+	void integrate(std::size_t first, std::size_t last, float dt);
+	void remove_dead();
+
+	template <class M>
+	void draw(const M& manager, const draw_particles_input input) const {
+		for (std::size_t i = 0; i < count; ++i) {
+			get(i).draw_as_sprite(manager, input);
+		}
+	}
+};
+
+class animated_particle_columns {
+	static constexpr auto N = animated_particle::statically_allocate;
+
+	template <class T = float>
+	using column = std::array<T, N>;
+
+	std::size_t count = 0;
+
+	particle_kinematics_columns<N> kinematics;
+
+	column<animation_in_particle> animation;
+	column<rgba> color;
+
+	/*
+		Scratch column, overwritten on every integration.
+		Zero for the particles whose animation tells them to stop moving.
+	*/
+
+	column<> steps;
+
+	template <class F>
+	void for_each_column(F&& callback) {
+		kinematics.for_each_column(callback);
+
+		callback(animation);
+		callback(color);
+	}
+
+public:
+	std::size_t size() const {
+		return count;
+	}
+
+	bool empty() const {
+		return count == 0;
+	}
+
+	bool full() const {
+		return count == N;
+	}
+
+	void clear() {
+		count = 0;
+	}
+
+	void push_back(const animated_particle&);
+	animated_particle get(std::size_t i) const;
+
+	void integrate(std::size_t first, std::size_t last, float dt, const plain_animations_pool& anims);
+	void remove_dead();
+
+	template <class M>
+	void draw(const M& manager, const plain_animations_pool& anims, const draw_particles_input input) const {
+		for (std::size_t i = 0; i < count; ++i) {
+			get(i).draw_as_sprite(manager, anims, input);
+		}
+	}
+};
@@ -94,7 +94,86 @@ void resize_image(
 
 void cut_empty_edges(augs::image& source);
 
-/* Thread local usage actually makes this slower, I have no idea why. */
+/*
+	Every light pixel is blended with whatever was already drawn around it,
+	so the result depends on the order of the light pixels.
+	That makes the blur impossible to split into two one-dimensional passes without altering the output.
+
+	Instead, the kernel is reduced once per distinct input to the alpha values it actually produces,
+	and only the span of each kernel row where that alpha is non-zero is ever visited.
+	With the default radius and deviation this skips the vast majority of the kernel.
+*/
+
+struct neon_alpha_kernel {
+	struct row_span {
+		unsigned first = 0;
+		unsigned last = 0;
+	};
+
+	std::vector<unsigned> alphas;
+	std::vector<row_span> spans;
+};
+
+bool same_kernel_input(const neon_map_input& a, const neon_map_input& b) {
+	return 
+		a.radius == b.radius 
+		&& a.standard_deviation == b.standard_deviation
+		&& a.amplification == b.amplification
+	;
+}
+
+const neon_alpha_kernel& get_alpha_kernel(const neon_map_input& input) {
+	struct cached_kernel {
+		neon_map_input input;
+		neon_alpha_kernel kernel;
+	};
+
+	thread_local std::vector<cached_kernel> cache;
+
+	for (const auto& c : cache) {
+		if (same_kernel_input(c.input, input)) {
+			return c.kernel;
+		}
+	}
+
+	thread_local std::vector<double> weights;
+	generate_gauss_kernel(input, weights);
+
+	auto& entry = cache.emplace_back();
+	entry.input = input;
+	entry.input.light_colors.clear();
+
+	auto& result = entry.kernel;
+
+	const auto rows = input.radius.y;
+	const auto cols = input.radius.x;
+
+	result.alphas.resize(rows * cols);
+	result.spans.resize(rows);
+
+	for (unsigned y = 0; y < rows; ++y) {
+		auto& span = result.spans[y];
+		bool found = false;
+
+		for (unsigned x = 0; x < cols; ++x) {
+			const auto i = y * cols + x;
+			const auto alpha = std::min(255u, static_cast<unsigned>(255 * weights[i] * input.amplification));
+
+			result.alphas[i] = alpha;
+
+			if (alpha) {
+				if (!found) {
+					span.first = x;
+					found = true;
+				}
+
+				span.last = x + 1;
+			}
+		}
+	}
+
+	return result;
+}
 
 void make_neon(
 	const neon_map_input& input,
@@ -104,11 +183,9 @@ void make_neon(
 
 	resize_image(source, radius);
 
-	thread_local std::vector<double> kernel_;
 	thread_local std::vector<vec2u> pixel_coordinates_;
 	thread_local std::vector<rgba> pixels_original_;
 
-	auto& kernel = kernel_;
 	auto& pixel_coordinates = pixel_coordinates_;
 	auto& pixels_original = pixels_original_; 
 
@@ -116,7 +193,8 @@ void make_neon(
 	pixels_original.clear();
 
 	scan_and_hide_undesired_pixels(source, input.light_colors, pixel_coordinates);
-	generate_gauss_kernel(input, kernel);
+
+	const auto& kernel = get_alpha_kernel(input);
 
 	for (const auto p : pixel_coordinates) {
 		pixels_original.emplace_back(source.pixel(p));
@@ -124,29 +202,38 @@ void make_neon(
 
 	const auto radius_rows = radius.y;
 	const auto radius_cols = radius.x;
-	const auto source_rows = source.get_rows();
-	const auto source_cols = source.get_columns();
+	const auto source_rows = static_cast<int>(source.get_rows());
+	const auto source_cols = static_cast<int>(source.get_columns());
 
 	for (std::size_t i = 0; i < pixel_coordinates.size(); ++i) {
 		const auto coord = pixel_coordinates[i];
 		const auto current_light_pixel = pixels_original[i];
 
+		const auto origin_x = static_cast<int>(coord.x) - static_cast<int>(radius.x / 2);
+		const auto origin_y = static_cast<int>(coord.y) - static_cast<int>(radius.y / 2);
+
+		/* Clip the kernel against the image once per row instead of checking every pixel. */
+
+		const auto first_x = static_cast<unsigned>(std::max(0, -origin_x));
+		const auto last_x = static_cast<unsigned>(std::max(0, std::min(static_cast<int>(radius_cols), source_cols - origin_x)));
+
 		for (unsigned y = 0; y < radius_rows; ++y) {
-			for (unsigned x = 0; x < radius_cols; ++x) {
-				const unsigned current_index_y = coord.y + y - radius.y / 2;
+			const auto target_y = origin_y + static_cast<int>(y);
 
-				if (current_index_y >= source_rows) {
-					continue;
-				}
+			if (target_y < 0 || target_y >= source_rows) {
+				continue;
+			}
 
-				const unsigned current_index_x = coord.x + x - radius.x / 2;
+			const auto span = kernel.spans[y];
+			const auto from = std::max(span.first, first_x);
+			const auto to = std::min(span.last, last_x);
 
-				if (current_index_x >= source_cols) {
-					continue;
-				}
+			const auto* const alpha_row = kernel.alphas.data() + y * radius_cols;
+			auto* const target_row = &source.pixel({ 0u, static_cast<unsigned>(target_y) });
 
-				if (const auto alpha = std::min(255u, static_cast<unsigned>(255 * kernel[y * radius_cols + x] * input.amplification))) {
-					auto& drawn_pixel = source.pixel({ current_index_x, current_index_y });
+			for (unsigned x = from; x < to; ++x) {
+				if (const auto alpha = alpha_row[x]) {
+					auto& drawn_pixel = target_row[origin_x + static_cast<int>(x)];
 
 					if (drawn_pixel == PIXEL_NONE) {
 						drawn_pixel[2] = current_light_pixel[2];
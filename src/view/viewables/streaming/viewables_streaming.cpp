@@ -1,5 +1,6 @@
 #include "augs/graphics/renderer.h"
 #include "augs/templates/thread_templates.h"
+#include "augs/templates/range_workers.h"
 #include "view/viewables/streaming/viewables_streaming.h"
 #include "view/audiovisual_state/systems/sound_system.h"
 #include "augs/templates/introspection_utils/introspective_equal.h"
@@ -197,27 +198,52 @@ void viewables_streaming::load_all(const viewables_load_input in) {
 		});
 
 		if (sound_requests.size() > 0) {
+			const auto num_workers = std::size_t(settings.sound_decoding_threads);
+
 			future_loaded_buffers = std::async(std::launch::async,
-				[&](){
+				[this, num_workers](){
 					using value_type = decltype(future_loaded_buffers.get());
 
 					auto scope = measure_scope(performance.reloading_sounds);
 
+					/* 
+						Every request is written to its own slot,
+						so the order of results matches sound_requests regardless of which worker decoded what.
+					*/
+
 					value_type result;
+					result.resize(sound_requests.size());
+
+					std::vector<double> decoding_secs;
+					decoding_secs.resize(sound_requests.size(), -1.0);
 
-					for (const auto& r : sound_requests) {
+					auto worker = [this, &result, &decoding_secs](const std::pair<assets::sound_id, augs::sound_buffer_loading_input>& r) {
 						if (r.second.source_sound.empty()) {
 							/* A request to unload. */
-							result.push_back(std::nullopt);
-							continue;
+							return;
 						}
 
+						const auto i = index_in(sound_requests, r);
+
+						augs::timer tm;
+
 						try {
-							augs::sound_buffer b = r.second;
-							result.emplace_back(std::move(b));
+							result[i].emplace(r.second);
 						}
 						catch (...) {
-							result.push_back(std::nullopt);
+							/* Leave the slot empty so that the sound is treated as missing. */
+						}
+
+						decoding_secs[i] = tm.get<std::chrono::seconds>();
+					};
+
+					static augs::range_workers<decltype(worker)> workers = num_workers;
+					workers.resize_workers(num_workers);
+					workers.process(worker, sound_requests);
+
+					for (const auto secs : decoding_secs) {
+						if (secs >= 0.0) {
+							performance.decoding_single_sound.measure(secs);
 						}
 					}
 
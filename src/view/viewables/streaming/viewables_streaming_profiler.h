@@ -7,6 +7,7 @@ struct viewables_streaming_profiler : public augs::profiler_mixin<viewables_stre
 
 	// GEN INTROSPECTOR struct viewables_streaming_profiler
 	augs::time_measurements reloading_sounds = std::size_t(1);
+	augs::time_measurements decoding_single_sound = std::size_t(100);
 	augs::time_measurements viewables_readback = std::size_t(1);
 	augs::time_measurements atlas_upload_to_gpu = std::size_t(1);
 	augs::time_measurements neon_maps_regeneration = std::size_t(1);
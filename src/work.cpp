@@ -54,11 +54,13 @@
 #include "application/gui/ingame_menu_gui.h"
 
 #include "application/setups/all_setups.h"
+#include "application/setups/server/multi_arena_host.h"
 
 #include "application/main/imgui_pass.h"
 #include "application/main/draw_debug_details.h"
 #include "application/main/draw_debug_lines.h"
 #include "application/main/release_flags.h"
+#include "application/main/headless_benchmark.h"
 #include "application/setups/editor/editor_player.hpp"
 
 #include "application/input/input_pass_result.h"
@@ -149,6 +151,9 @@ int work(const int argc, const char* const * const argv) try {
 		LOG("Live log file created at %x", augs::date_time().get_readable());
 	}
 
+	performance.set_window_of_measurements(config.debug.profiler_window);
+	network_performance.set_window_of_measurements(config.debug.profiler_window);
+
 	LOG("Initializing ImGui.");
 	augs::imgui::init(
 		LOCAL_FILES_DIR "/imgui.ini",
@@ -173,7 +178,7 @@ int work(const int argc, const char* const * const argv) try {
 	LOG("Initializing global libraries");
 
 	static const auto libraries = 
-		params.start_dedicated_server 
+		params.start_dedicated_server || params.headless_benchmark
 		? augs::global_libraries({}) 
 		: augs::global_libraries(augs::global_libraries::library::FREETYPE) 
 	;
@@ -218,6 +223,65 @@ int work(const int argc, const char* const * const argv) try {
 		LOG("Unit tests were disabled.");
 	}
 
+#if PLATFORM_UNIX
+	static auto received_shutdown_signal = []() {
+		if (signal_status != 0) {
+			const auto sig = signal_status;
+
+			LOG("%x received.", strsignal(sig));
+
+			if(
+				sig == SIGINT
+				|| sig == SIGSTOP
+				|| sig == SIGTERM
+			) {
+				LOG("Gracefully shutting down.");
+				return true;
+			}
+		}
+
+		return false;
+	};
+#else
+	static auto received_shutdown_signal = []() {
+		return false;
+	};
+#endif
+
+	if (params.headless_benchmark) {
+		LOG("Running the headless benchmark.");
+		run_headless_benchmark(lua, config.headless_benchmark);
+
+		return EXIT_SUCCESS;
+	}
+
+	if (params.start_dedicated_server && !config.dedicated_server.trace_file_path.empty()) {
+		augs::start_trace_recording(config.dedicated_server.trace_file_path);
+	}
+
+	auto stop_tracing = augs::scope_guard([]() { augs::stop_trace_recording(); });
+
+	if (params.start_dedicated_server && config.dedicated_server.num_arenas > 1) {
+		LOG("Starting a dedicated server with %x arenas.", config.dedicated_server.num_arenas);
+
+		static multi_arena_host host(
+			lua,
+			config.default_server_start,
+			config.server,
+			config.dedicated_server
+		);
+
+		while (host.is_running()) {
+			if (received_shutdown_signal()) {
+				break;
+			}
+
+			host.advance(config.input);
+		}
+
+		return EXIT_SUCCESS;
+	}
+
 	if (params.start_dedicated_server) {
 		LOG("Starting the dedicated server at port: %x", config.default_server_start.port);
 
@@ -234,22 +298,9 @@ int work(const int argc, const char* const * const argv) try {
 		while (server.is_running()) {
 			auto scope = measure_scope(performance.fps);
 
-#if PLATFORM_UNIX
-			if (signal_status != 0) {
-				const auto sig = signal_status;
-
-				LOG("%x received.", strsignal(sig));
-
-				if(
-					sig == SIGINT
-					|| sig == SIGSTOP
-					|| sig == SIGTERM
-				) {
-					LOG("Gracefully shutting down.");
-					break;
-				}
+			if (received_shutdown_signal()) {
+				break;
 			}
-#endif
 
 			const auto zoom = 1.f;
 
@@ -369,6 +420,11 @@ int work(const int argc, const char* const * const argv) try {
 		return audiovisuals;
 	};
 
+	frame_performance.set_window_of_measurements(config.debug.profiler_window);
+	atlas_performance.set_window_of_measurements(config.debug.profiler_window);
+	streaming.performance.set_window_of_measurements(config.debug.profiler_window);
+	audiovisuals.performance.set_window_of_measurements(config.debug.profiler_window);
+
 
 	/*
 		The lambdas that aid to make the main loop code more concise.
@@ -438,6 +494,7 @@ int work(const int argc, const char* const * const argv) try {
 	static auto setup_launcher = [&](auto&& setup_init_callback) {
 		game_gui_mode_flag = false;
 		get_audiovisuals().get<sound_system>().clear();
+		get_audiovisuals().get<static_batch_system>().clear();
 
 		network_stats = {};
 		server_stats = {};
@@ -792,6 +849,11 @@ int work(const int argc, const char* const * const argv) try {
 		
 		auto& interp = get_audiovisuals().get<interpolation_system>();
 
+		on_specific_setup([&](editor_setup&) {
+			/* Editor commands modify the scenery in place without notifying anyone. */
+			get_audiovisuals().get<static_batch_system>().mark_changed_in_place();
+		});
+
 		{
 			auto scope = measure_scope(get_audiovisuals().performance.interpolation);
 
@@ -832,7 +894,9 @@ int work(const int argc, const char* const * const argv) try {
 			streaming.loaded_sounds,
 
 			viewing_config.audio_volume,
-			viewing_config.sound
+			viewing_config.sound,
+
+			viewing_config.drawing.particle_integration_threads
 		});
 	};
 
@@ -1014,24 +1078,10 @@ int work(const int argc, const char* const * const argv) try {
 
 		auto scope = measure_scope(performance.fps);
 		
-#if PLATFORM_UNIX
-		if (signal_status != 0) {
-			const auto sig = signal_status;
-
-			LOG("%x received.", strsignal(sig));
-
-			if(
-				sig == SIGINT
-				|| sig == SIGSTOP
-				|| sig == SIGTERM
-			) {
-				LOG("Gracefully shutting down.");
-				should_quit = true;
-				
-				break;
-			}
+		if (received_shutdown_signal()) {
+			should_quit = true;
+			break;
 		}
-#endif
 
 		const auto frame_delta = frame_timer.extract_delta();
 